@@ -1,38 +1,540 @@
 // ronavraham99@gmail.com
 
 #include "AdjacencyList.hpp"
-#include <iostream> 
+#include "SimdSearch.hpp"
+#include <iostream>
 
 namespace graph {
 
+/// Default thresholds: index hubs past 32 edges, dense rows past a quarter of the graph (more if weighted).
+StoragePolicy::StoragePolicy()
+    : hashThreshold(AdjacencyList::HASH_INDEX_THRESHOLD),
+      hashRelease(AdjacencyList::HASH_INDEX_RELEASE),
+      denseMinVertices(256),
+      denseRatio(0.25),
+      denseReleaseRatio(0.125) {}
+
+static_assert(sizeof(BasicBlock<int, int>) == 128, "a block should span two cache lines");
+static_assert(sizeof(BasicBlock<int, Unweighted>) == 128, "a block should span two cache lines");
+
 /**
- * @class AdjacencyList
- * @brief Represents a singly linked adjacency list for graph edges.
- * 
- * Each node in the list stores the destination vertex and the edge weight.
- * Provides methods to add, remove, and query edges.
+ * @brief Context used by lists that are not owned by a Graph: no dense rows.
+ *
+ * Built on first use rather than at namespace scope, so a list constructed
+ * during another file's static initialization never sees it uninitialized.
  */
-AdjacencyList::AdjacencyList() {
-    head = nullptr; ///< Initialize head pointer to null (empty list).
+static const StorageContext* defaultContext() {
+    static const StorageContext context = {StoragePolicy(), 0};
+    return &context;
+}
+
+/**
+ * @brief SIMD search over a destination array of any supported vertex type.
+ *
+ * 32-bit IDs share the int kernel and 64-bit IDs the long long kernel;
+ * equality does not depend on signedness.
+ */
+template <typename V>
+static int searchSlot(const V* values, int count, V key) {
+    static_assert(sizeof(V) == 4 || sizeof(V) == 8, "vertex IDs must be 32 or 64 bits");
+    if constexpr (sizeof(V) == 4) {
+        return findSlot(reinterpret_cast<const int*>(values), count, static_cast<int>(key));
+    } else {
+        return findSlot(reinterpret_cast<const long long*>(values), count, static_cast<long long>(key));
+    }
 }
 
-AdjacencyList::~AdjacencyList() {
-    Node* current = head;
+/**
+ * @class BasicAdjacencyList
+ * @brief Represents an unrolled linked adjacency list for graph edges.
+ *
+ * The first INLINE_CAPACITY edges live inside the list object itself, so
+ * low-degree vertices need no heap allocation at all. Past that, edges are
+ * stored in fixed-size blocks holding separate destination and weight
+ * arrays. Only the head block may be partially filled, so adding an edge
+ * is O(1) and removing one fills the hole with the last edge of the head
+ * block.
+ * The encoding adapts to the degree as set by the StoragePolicy: hub lists
+ * get a hash index from destination to slot, and lists covering a large
+ * fraction of the graph become a dense bitmap row.
+ */
+template <typename V, typename W>
+BasicAdjacencyList<V, W>::BasicAdjacencyList() {
+    context = defaultContext();
+    degree = 0;
+    spilled = false;    ///< Start with the (empty) inline storage.
+}
+
+template <typename V, typename W>
+BasicAdjacencyList<V, W>::~BasicAdjacencyList() {
+    if (!spilled) return;
+
+    Block* current = spill.head;
     while (current != nullptr) {
-        Node* temp = current;       ///< Save pointer before moving to next node.
+        Block* temp = current;      ///< Save pointer before moving to next block.
         current = current->next;    ///< Advance iterator.
-        delete temp;                ///< Free memory to avoid leaks.
+        release(temp);              ///< Free memory to avoid leaks.
+    }
+    delete spill.index;
+    delete spill.dense;
+}
+
+/**
+ * @brief Attach the settings of the owning graph.
+ * @param shared Thresholds and vertex count, must outlive the list.
+ * @note Meant to be called on an empty list, right after construction.
+ */
+template <typename V, typename W>
+void BasicAdjacencyList<V, W>::configure(const StorageContext* shared) {
+    context = shared;
+}
+
+/**
+ * @brief Number of blocks a bulk-built list of count edges needs.
+ * @return 0 if the edges fit inline, otherwise enough blocks for all of them.
+ */
+template <typename V, typename W>
+V BasicAdjacencyList<V, W>::blocksFor(V count) {
+    if (count <= static_cast<V>(INLINE_CAPACITY)) return 0;
+    return (count + Block::CAPACITY - 1) / Block::CAPACITY;
+}
+
+/**
+ * @brief Write the at-th edge of a bulk fill, in insertion order.
+ *
+ * Edges go inline when blocks is nullptr, otherwise into slot
+ * at % CAPACITY of blocks[at / CAPACITY]. Different slots of one list may
+ * be written from different threads.
+ * @param at Position of the edge among the list's edges.
+ * @param dest Destination vertex.
+ * @param weight Weight of the edge.
+ * @param blocks blocksFor(count) contiguous blocks, or nullptr if the edges fit inline.
+ */
+template <typename V, typename W>
+void BasicAdjacencyList<V, W>::place(V at, V dest, W weight, Block* blocks) {
+    if (blocks == nullptr) {
+        local.dest[at] = dest;
+        local.weight[at] = weight;
+        return;
+    }
+    Block& block = blocks[at / Block::CAPACITY];
+    block.dest[at % Block::CAPACITY] = dest;
+    if constexpr (WEIGHTED) block.weight[at % Block::CAPACITY] = weight;
+}
+
+/**
+ * @brief Finish a bulk fill started with place().
+ *
+ * Block edges are in insertion order, Block::CAPACITY per block, so every
+ * block is full except possibly the last; their `used` and `next` fields
+ * are set here. The blocks stay owned by the caller's arena.
+ * @param blocks The blocks passed to place(), or nullptr if the edges are inline.
+ * @param count Number of edges placed.
+ * @note Meant to be called on an empty, configured list.
+ */
+template <typename V, typename W>
+void BasicAdjacencyList<V, W>::adopt(Block* blocks, V count) {
+    if (blocks == nullptr) {
+        degree = count;
+        return;
+    }
+    V blockCount = blocksFor(count);
+    for (V i = 0; i < blockCount; ++i) {
+        blocks[i].next = (i == 0) ? nullptr : &blocks[i - 1];  ///< Newest block first.
+        blocks[i].used = Block::CAPACITY;
+        blocks[i].pooled = true;
+    }
+    blocks[blockCount - 1].used = static_cast<int>(count - (blockCount - 1) * Block::CAPACITY);
+
+    spill.head = &blocks[blockCount - 1];
+    spill.index = nullptr;
+    spill.dense = nullptr;
+    spill.parallel = 0;
+    spilled = true;
+    degree = count;
+    adapt();
+}
+
+/// Free a block unless it belongs to a bulk builder's arena.
+template <typename V, typename W>
+void BasicAdjacencyList<V, W>::release(Block* block) {
+    if (!block->pooled) delete block;
+}
+
+/**
+ * @brief Visit every edge as (dest, weight).
+ *
+ * Inline and block storage are visited newest edge first; dense rows in
+ * ascending destination order.
+ */
+template <typename V, typename W>
+template <typename Visitor>
+void BasicAdjacencyList<V, W>::forEachEdge(Visitor visit) const {
+    if (!spilled) {
+        for (int i = static_cast<int>(degree) - 1; i >= 0; --i) {
+            visit(local.dest[i], local.weight[i]);
+        }
+        return;
+    }
+    if (spill.dense != nullptr) {
+        long long words = (context->universe + 63) / 64;
+        for (long long w = 0; w < words; ++w) {
+            unsigned long long word = spill.dense->bits[w];
+            while (word != 0) {
+                V v = static_cast<V>(w * 64 + __builtin_ctzll(word));
+                visit(v, WEIGHTED ? spill.dense->weights[v] : W());
+                word &= word - 1;   ///< Clear the lowest set bit.
+            }
+        }
+        return;
+    }
+    for (Block* block = spill.head; block != nullptr; block = block->next) {
+        for (int i = block->used - 1; i >= 0; --i) {
+            if constexpr (WEIGHTED) {
+                visit(block->dest[i], block->weight[i]);
+            } else {
+                visit(block->dest[i], W());
+            }
+        }
     }
 }
 
+/// Move the inline edges into a freshly allocated block.
+template <typename V, typename W>
+void BasicAdjacencyList<V, W>::spillLocal() {
+    Local saved = local;    ///< The union is about to be overwritten.
+    spill.head = nullptr;
+    spill.index = nullptr;
+    spill.dense = nullptr;
+    spill.parallel = 0;
+    spilled = true;
+    for (int i = 0; i < static_cast<int>(degree); ++i) {
+        append(saved.dest[i], saved.weight[i]);
+    }
+}
+
+/// Move the edges of a shrunken list back inline and free its heap storage.
+template <typename V, typename W>
+void BasicAdjacencyList<V, W>::unspill() {
+    Local saved;
+    int i = static_cast<int>(degree);
+    forEachEdge([&saved, &i](V dest, W weight) {
+        --i;                ///< Newest first in, so fill from the top.
+        saved.dest[i] = dest;
+        saved.weight[i] = weight;
+    });
+
+    while (spill.head != nullptr) {
+        Block* temp = spill.head;
+        spill.head = spill.head->next;
+        release(temp);
+    }
+    delete spill.index;
+    delete spill.dense;
+
+    spilled = false;
+    local = saved;
+}
+
+/**
+ * @brief Push an edge onto the head block, without index bookkeeping.
+ * @param dest Destination vertex.
+ * @param weight Weight of the edge.
+ */
+template <typename V, typename W>
+void BasicAdjacencyList<V, W>::append(V dest, W weight) {
+    Block*& head = spill.head;
+    if (head == nullptr || head->used == Block::CAPACITY) {
+        head = new Block(head); ///< Start a new block at the beginning.
+    }
+    int slot = head->used++;
+    head->dest[slot] = dest;
+    if constexpr (WEIGHTED) head->weight[slot] = weight;
+}
+
+/**
+ * @brief Build the destination index over the current list.
+ *
+ * Called once the degree crosses the policy's hash threshold.
+ */
+template <typename V, typename W>
+void BasicAdjacencyList<V, W>::buildIndex() {
+    HashIndex<V, Entry>* index = new HashIndex<V, Entry>(static_cast<int>(degree));
+    spill.parallel = 0;
+    for (Block* block = spill.head; block != nullptr; block = block->next) {
+        for (int i = block->used - 1; i >= 0; --i) {
+            Entry* entry = index->find(block->dest[i]);
+            if (entry != nullptr) {
+                entry->copies++;    ///< Parallel edge, keep the first slot found.
+                spill.parallel++;
+            } else {
+                Entry fresh = {block, i, 1};
+                index->insert(block->dest[i], fresh);
+            }
+        }
+    }
+    spill.index = index;
+}
+
+/// Release the destination index.
+template <typename V, typename W>
+void BasicAdjacencyList<V, W>::dropIndex() {
+    delete spill.index;
+    spill.index = nullptr;
+    spill.parallel = 0;
+}
+
+/**
+ * @brief Factor by which this list raises the policy's dense ratios.
+ *
+ * A weighted dense row holds a weight slot for every vertex, so it costs
+ * 1/8 + sizeof(W) bytes per vertex against sizeof(Block) / CAPACITY per
+ * edge in blocks. The ratios are raised until the row is no larger than
+ * the blocks it replaces (about 0.45 for int weights); unweighted and
+ * byte-weighted rows are already smaller at the default ratio.
+ */
+template <typename V, typename W>
+double BasicAdjacencyList<V, W>::denseScale() const {
+    double rowBytes = 1.0 / 8 + (WEIGHTED ? sizeof(W) : 0);
+    double needed = rowBytes / (static_cast<double>(sizeof(Block)) / Block::CAPACITY);
+    double ratio = context->policy.denseRatio;
+    return ratio > 0 && needed > ratio ? needed / ratio : 1.0;
+}
+
+/**
+ * @brief Whether the list should switch to a dense bitmap row.
+ *
+ * Only indexed lists qualify, since the index is what tells us the list
+ * has no parallel edges (which a bitmap cannot hold).
+ */
+template <typename V, typename W>
+bool BasicAdjacencyList<V, W>::wantsDense() const {
+    const StoragePolicy& policy = context->policy;
+    return spill.index != nullptr && spill.parallel == 0 &&
+           context->universe >= policy.denseMinVertices &&
+           degree >= policy.denseRatio * denseScale() * context->universe;
+}
+
+/// Attach the index or dense row that a freshly filled list of this degree calls for.
+template <typename V, typename W>
+void BasicAdjacencyList<V, W>::adapt() {
+    if (static_cast<long long>(degree) > context->policy.hashThreshold) buildIndex();
+    if (wantsDense()) toDense();
+}
+
+/// Convert the block list into a dense bitmap row.
+template <typename V, typename W>
+void BasicAdjacencyList<V, W>::toDense() {
+    DenseRow<W>* row = new DenseRow<W>(context->universe);
+    forEachEdge([row](V dest, W weight) {
+        row->set(dest);
+        if constexpr (WEIGHTED) row->weights[dest] = weight;
+    });
+
+    while (spill.head != nullptr) {
+        Block* temp = spill.head;
+        spill.head = spill.head->next;
+        release(temp);
+    }
+    dropIndex();
+    spill.dense = row;
+}
+
+/// Convert a dense bitmap row back into a block list.
+template <typename V, typename W>
+void BasicAdjacencyList<V, W>::toList() {
+    DenseRow<W>* row = spill.dense;
+    long long words = (context->universe + 63) / 64;
+    spill.dense = nullptr;
+    for (long long w = 0; w < words; ++w) {
+        unsigned long long word = row->bits[w];
+        while (word != 0) {
+            V v = static_cast<V>(w * 64 + __builtin_ctzll(word));
+            append(v, WEIGHTED ? row->weights[v] : W());
+            word &= word - 1;
+        }
+    }
+    delete row;
+
+    if (static_cast<long long>(degree) > context->policy.hashThreshold) buildIndex();
+}
+
+/**
+ * @brief Linear search for a slot holding the given destination.
+ *
+ * Scans newest edges first: blocks from the head, slots from the top.
+ * @param dest Destination vertex.
+ * @param block Set to the block holding the edge.
+ * @param slot Set to the slot of the edge inside the block.
+ * @return True if found, false otherwise.
+ */
+template <typename V, typename W>
+bool BasicAdjacencyList<V, W>::locate(V dest, Block*& block, int& slot) const {
+    for (Block* current = spill.head; current != nullptr; current = current->next) {
+        int i = searchSlot(current->dest, current->used, dest);  ///< SIMD compare over the block.
+        if (i >= 0) {
+            block = current;
+            slot = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Find a slot holding the given destination, using the index if present.
+ * @param dest Destination vertex.
+ * @param block Set to the block holding the edge.
+ * @param slot Set to the slot of the edge inside the block.
+ * @return True if found, false otherwise.
+ */
+template <typename V, typename W>
+bool BasicAdjacencyList<V, W>::find(V dest, Block*& block, int& slot) const {
+    if (spill.index == nullptr) return locate(dest, block, slot);
+
+    Entry* entry = spill.index->find(dest);
+    if (entry == nullptr) return false;
+    block = entry->block;
+    slot = entry->slot;
+    return true;
+}
+
 /**
  * @brief Add a new edge to the adjacency list.
  * @param dest Destination vertex.
  * @param weight Weight of the edge.
  */
-void AdjacencyList::addEdge(int dest, int weight) {
-    Node* newNode = new Node(dest, weight, head); ///< Insert at the beginning.
-    head = newNode;
+template <typename V, typename W>
+void BasicAdjacencyList<V, W>::addEdge(V dest, W weight) {
+    if (!spilled) {
+        if (degree < INLINE_CAPACITY) {
+            local.dest[degree] = dest;
+            local.weight[degree] = weight;
+            ++degree;
+            return;
+        }
+        spillLocal();   ///< Inline storage is full.
+    }
+
+    if (spill.dense != nullptr) {
+        if (!spill.dense->test(dest)) {
+            spill.dense->set(dest);
+            if constexpr (WEIGHTED) spill.dense->weights[dest] = weight;
+            ++degree;
+            return;
+        }
+        toList();   ///< A parallel edge does not fit in a bitmap row.
+    }
+
+    append(dest, weight);
+    ++degree;
+
+    Block* head = spill.head;
+    if (spill.index != nullptr) {
+        Entry* entry = spill.index->find(dest);
+        if (entry != nullptr) {
+            entry->block = head;    ///< Newest edge first, like a list scan.
+            entry->slot = head->used - 1;
+            entry->copies++;
+            spill.parallel++;
+        } else {
+            Entry fresh = {head, head->used - 1, 1};
+            spill.index->insert(dest, fresh);
+        }
+    } else if (static_cast<long long>(degree) > context->policy.hashThreshold) {
+        buildIndex();
+    }
+
+    if (wantsDense()) toDense();
+}
+
+/**
+ * @brief Add several edges to the adjacency list.
+ *
+ * Same result as calling addEdge for each edge in order, but a plain block
+ * list appends them all first and decides on an index or dense row once,
+ * from the final degree.
+ * @param dests Destination vertices.
+ * @param weights Weights, parallel to dests.
+ * @param count Number of edges.
+ */
+template <typename V, typename W>
+void BasicAdjacencyList<V, W>::addEdges(const V* dests, const W* weights, V count) {
+    V i = 0;
+    if (!spilled) {
+        for (; i < count && degree < INLINE_CAPACITY; ++i) {
+            local.dest[degree] = dests[i];
+            local.weight[degree] = weights[i];
+            ++degree;
+        }
+        if (i == count) return;
+        spillLocal();
+    }
+
+    if (spill.dense != nullptr || spill.index != nullptr) {
+        for (; i < count; ++i) addEdge(dests[i], weights[i]);    ///< Already O(1) per edge.
+        return;
+    }
+    for (; i < count; ++i) {
+        append(dests[i], weights[i]);
+        ++degree;
+    }
+    adapt();
+}
+
+/**
+ * @brief Remove the edge stored at a given slot.
+ *
+ * The last edge of the head block is moved into the hole, and the head
+ * block is freed once it becomes empty.
+ * @param block Block holding the edge.
+ * @param slot Slot of the edge inside the block.
+ */
+template <typename V, typename W>
+void BasicAdjacencyList<V, W>::removeAt(Block* block, int slot) {
+    Block*& head = spill.head;
+    HashIndex<V, Entry>* index = spill.index;
+    V removed = block->dest[slot];
+    int last = head->used - 1;
+    bool repoint = false;   ///< Whether the removed destination's entry lost its slot.
+
+    if (index != nullptr) {
+        Entry* entry = index->find(removed);
+        repoint = (entry->block == block && entry->slot == slot) ||
+                  (entry->block == head && entry->slot == last);
+    }
+
+    if (block != head || slot != last) {
+        V moved = head->dest[last];
+        block->dest[slot] = moved;
+        if constexpr (WEIGHTED) block->weight[slot] = head->weight[last];
+        if (index != nullptr && moved != removed) {
+            Entry* entry = index->find(moved);
+            if (entry->block == head && entry->slot == last) {
+                entry->block = block;
+                entry->slot = slot;
+            }
+        }
+    }
+
+    if (--head->used == 0) {
+        Block* old = head;
+        head = head->next;
+        release(old);
+    }
+    --degree;
+
+    if (index == nullptr) return;
+
+    Entry* entry = index->find(removed);
+    if (--entry->copies == 0) {
+        index->erase(removed);
+    } else {
+        spill.parallel--;
+        if (repoint) locate(removed, entry->block, entry->slot);   ///< Rare: re-point at a parallel edge.
+    }
+
+    if (static_cast<long long>(degree) < context->policy.hashRelease) dropIndex();
 }
 
 /**
@@ -40,25 +542,100 @@ void AdjacencyList::addEdge(int dest, int weight) {
  * @param dest Destination vertex to remove.
  * @throws const char* if the edge is not found.
  */
-void AdjacencyList::removeEdge(int dest) {
-    Node* current = head;
-    Node* prev = nullptr;
+template <typename V, typename W>
+void BasicAdjacencyList<V, W>::removeEdge(V dest) {
+    if (!spilled) {
+        int i = searchSlot(local.dest, static_cast<int>(degree), dest);
+        if (i < 0) throw "Edge not found";
+        --degree;
+        local.dest[i] = local.dest[degree];     ///< Fill the hole with the newest edge.
+        local.weight[i] = local.weight[degree];
+        return;
+    }
 
-    while (current != nullptr) {
-        if (current->dest == dest) {
-            if (prev == nullptr) {
-                head = current->next;   ///< Edge is the first node.
-            } else {
-                prev->next = current->next;
+    if (spill.dense != nullptr) {
+        if (!spill.dense->test(dest)) throw "Edge not found";
+        spill.dense->clear(dest);
+        --degree;
+        if (static_cast<double>(degree) < context->policy.denseReleaseRatio * denseScale() * context->universe) {
+            toList();
+        }
+    } else {
+        Block* block;
+        int slot;
+        if (!find(dest, block, slot)) {
+            throw "Edge not found"; ///< No matching edge in list.
+        }
+        removeAt(block, slot);
+    }
+
+    if (degree <= INLINE_RELEASE) unspill();
+}
+
+/**
+ * @brief Remove several edges, skipping destinations that are not in the list.
+ *
+ * Each entry removes one edge, so a destination listed twice removes two
+ * parallel edges. Inline, indexed and dense lists remove edge by edge,
+ * which is O(1) each. A plain block list is compacted in a single pass
+ * instead of one scan per edge; the edges it keeps stay in their order.
+ * @param dests Destination vertices to remove.
+ * @param count Number of entries.
+ * @return Number of edges removed.
+ */
+template <typename V, typename W>
+V BasicAdjacencyList<V, W>::removeEdges(const V* dests, V count) {
+    V removed = 0;
+    if (!spilled || spill.dense != nullptr || spill.index != nullptr || count == 1) {
+        for (V i = 0; i < count; ++i) {
+            if (contains(dests[i])) {
+                removeEdge(dests[i]);
+                ++removed;
             }
-            delete current;
-            return;
         }
-        prev = current;
-        current = current->next;
+        return removed;
     }
 
-    throw "Edge not found"; ///< No matching edge in list.
+    HashIndex<V, V> pending(static_cast<int>(count));     ///< Copies left to remove per destination.
+    for (V i = 0; i < count; ++i) {
+        V* copies = pending.find(dests[i]);
+        if (copies != nullptr) {
+            ++*copies;
+        } else {
+            pending.insert(dests[i], 1);
+        }
+    }
+
+    V* keptDest = new V[degree];
+    W* keptWeight = WEIGHTED ? new W[degree] : nullptr;
+    V kept = 0;
+    forEachEdge([&](V dest, W weight) {
+        V* copies = pending.find(dest);
+        if (copies != nullptr && *copies > 0) {
+            --*copies;
+            ++removed;
+            return;
+        }
+        keptDest[kept] = dest;
+        if constexpr (WEIGHTED) keptWeight[kept] = weight;
+        ++kept;
+    });
+
+    if (removed > 0) {
+        while (spill.head != nullptr) {
+            Block* temp = spill.head;
+            spill.head = spill.head->next;
+            release(temp);
+        }
+        for (V i = kept; i > 0; --i) {      ///< Oldest first, so the visit order is unchanged.
+            append(keptDest[i - 1], WEIGHTED ? keptWeight[i - 1] : W());
+        }
+        degree = kept;
+        if (degree <= INLINE_RELEASE) unspill();
+    }
+    delete[] keptDest;
+    delete[] keptWeight;
+    return removed;
 }
 
 /**
@@ -66,42 +643,50 @@ void AdjacencyList::removeEdge(int dest) {
  * @param dest Destination vertex to search for.
  * @return True if found, false otherwise.
  */
-bool AdjacencyList::contains(int dest) const {
-    Node* current = head;
-    while (current != nullptr) {
-        if (current->dest == dest) {
-            return true;
-        }
-        current = current->next;
-    }
-    return false;
+template <typename V, typename W>
+bool BasicAdjacencyList<V, W>::contains(V dest) const {
+    if (!spilled) return searchSlot(local.dest, static_cast<int>(degree), dest) >= 0;
+    if (spill.dense != nullptr) return spill.dense->test(dest);
+    Block* block;
+    int slot;
+    return find(dest, block, slot);
 }
 
 /**
- * @brief Print all edges in the adjacency list.
- * 
+ * @brief Print all edges in the adjacency list to std::cout.
+ *
  * Format: (destination, weight)
  */
-void AdjacencyList::print() const {
-    Node* current = head;
-    while (current != nullptr) {
-        std::cout << "(" << current->dest << ", weight " << current->weight << ") ";
-        current = current->next;
-    }
+template <typename V, typename W>
+void BasicAdjacencyList<V, W>::print() const {
+    OutputBuffer out(std::cout);
+    print(out);
+    out.flush();
+}
+
+/**
+ * @brief Append all edges in the adjacency list to a buffer.
+ *
+ * Format: (destination, weight)
+ */
+template <typename V, typename W>
+void BasicAdjacencyList<V, W>::print(OutputBuffer& out) const {
+    forEachEdge([&out](V dest, W weight) {
+        out.put('(');
+        out.putNumber(dest);
+        out.put(", weight ");
+        out.putNumber(weight);     ///< uint8_t prints as a number.
+        out.put(") ");
+    });
 }
 
 /**
  * @brief Count the number of edges in the adjacency list.
- * @return Number of nodes in the list.
+ * @return Number of edges in the list.
  */
-int AdjacencyList::count() const {
-    int c = 0;
-    Node* current = head;
-    while (current != nullptr) {
-        ++c;                  ///< Increment for each node.
-        current = current->next;
-    }
-    return c;
+template <typename V, typename W>
+V BasicAdjacencyList<V, W>::count() const {
+    return degree;            ///< Maintained by addEdge/removeEdge.
 }
 
 /**
@@ -109,31 +694,69 @@ int AdjacencyList::count() const {
  * @return Dynamically allocated array of neighbor IDs.
  * @note Caller is responsible for freeing the returned array.
  */
-int* AdjacencyList::getAllNeighbors() const {
-    int c = count();
-    int* neighbors = new int[c];
-    Node* current = head;
-    int i = 0;
-    while (current != nullptr) {
-        neighbors[i++] = current->dest;
-        current = current->next;
-    }
+template <typename V, typename W>
+V* BasicAdjacencyList<V, W>::getAllNeighbors() const {
+    V* neighbors = new V[degree];
+    long long i = 0;
+    forEachEdge([neighbors, &i](V dest, W) {
+        neighbors[i++] = dest;
+    });
     return neighbors;
 }
 
+/**
+ * @brief Get the weights of all edges, in the order of getAllNeighbors().
+ * @return Dynamically allocated array of edge weights, or nullptr for an unweighted list.
+ * @note Caller is responsible for freeing the returned array.
+ */
+template <typename V, typename W>
+W* BasicAdjacencyList<V, W>::getAllWeights() const {
+    if constexpr (!WEIGHTED) return nullptr;   ///< No weights stored, every edge counts as 1.
+    W* weights = new W[degree];
+    long long i = 0;
+    forEachEdge([weights, &i](V, W weight) {
+        weights[i++] = weight;
+    });
+    return weights;
+}
+
 /**
  * @brief Retrieve the weight of an edge to a given destination.
  * @param dest Destination vertex.
- * @return Edge weight if found, otherwise -1.
+ * @return Edge weight if found, otherwise none<W>() (-1 for signed weights).
+ *         Unweighted lists report 1 or -1.
  */
-int AdjacencyList::getWeight(int dest) const {
-    Node* current = head;
-    while (current != nullptr) {
-        if (current->dest == dest)
-            return current->weight;
-        current = current->next;
+template <typename V, typename W>
+WeightResult<W> BasicAdjacencyList<V, W>::getWeight(V dest) const {
+    if constexpr (!WEIGHTED) {
+        return contains(dest) ? 1 : -1;
+    } else {
+        if (!spilled) {
+            int i = searchSlot(local.dest, static_cast<int>(degree), dest);
+            return (i >= 0) ? local.weight[i] : none<W>();
+        }
+        if (spill.dense != nullptr) {
+            return spill.dense->test(dest) ? spill.dense->weights[dest] : none<W>();
+        }
+        Block* block;
+        int slot;
+        if (find(dest, block, slot))
+            return block->weight[slot];
+        return none<W>(); ///< Indicates no such edge exists.
     }
-    return -1; ///< Indicates no such edge exists.
 }
 
+/// @return The encoding the list currently uses.
+template <typename V, typename W>
+typename BasicAdjacencyList<V, W>::Encoding BasicAdjacencyList<V, W>::encoding() const {
+    if (!spilled) return Encoding::INLINE;
+    if (spill.dense != nullptr) return Encoding::DENSE;
+    if (spill.index != nullptr) return Encoding::HASHED;
+    return Encoding::LIST;
+}
+
+#define GRAPH_INSTANTIATE_ADJACENCY(V, W) template class BasicAdjacencyList<V, W>;
+GRAPH_FOR_EACH_TYPE_PAIR(GRAPH_INSTANTIATE_ADJACENCY)
+#undef GRAPH_INSTANTIATE_ADJACENCY
+
 } // namespace graph
@@ -3,44 +3,228 @@
 #ifndef ADJACENCY_LIST_HPP
 #define ADJACENCY_LIST_HPP
 
+#include "DataStructures.hpp"
+#include "OutputBuffer.hpp"
+
 namespace graph {
-    
+
+/**
+ * @struct BasicBlock
+ * @brief A fixed-size chunk of an unrolled adjacency list.
+ *
+ * Destinations and weights are kept in separate arrays (structure of
+ * arrays), so a scan for a destination touches only the destination
+ * cache lines of each block. 14 edges per block, and one `next` pointer
+ * per block instead of one per edge; with int IDs and weights a block is
+ * exactly two cache lines.
+ * @tparam V Vertex ID type.
+ * @tparam W Weight type.
+ */
+template <typename V, typename W>
+struct alignas(64) BasicBlock {
+    static constexpr int CAPACITY = 14;  ///< Edges per block.
+
+    V dest[CAPACITY];       ///< Destination vertices.
+    BasicBlock* next;       ///< Pointer to the next block.
+    W weight[CAPACITY];     ///< Weights of the edges, parallel to dest.
+    int used;               ///< Number of filled slots.
+    bool pooled;            ///< Owned by a graph's block arena, not freed with the list.
+
+    BasicBlock(BasicBlock* n = nullptr) : next(n), used(0), pooled(false) {}
+};
+
 /**
- * @struct Node
- * @brief Represents a single node in the adjacency list.
- * 
- * Each node stores the destination vertex, the edge weight,
- * and a pointer to the next node in the list.
+ * @brief Block of an unweighted list: destinations only.
+ *
+ * Without the weight array the same two cache lines hold twice as many
+ * 32-bit destinations.
  */
-struct Node {
-    int dest; ///< Destination vertex.
-    int weight;//< Weight of the edge.
-    Node* next;//< Pointer to the next node.
-
-  
-    Node(int d, int w, Node* n = nullptr) 
-        : dest(d), weight(w), next(n) {} 
+template <typename V>
+struct alignas(64) BasicBlock<V, Unweighted> {
+    static constexpr int CAPACITY = (128 - 16) / sizeof(V);  ///< Edges per block.
+
+    V dest[CAPACITY];       ///< Destination vertices.
+    BasicBlock* next;       ///< Pointer to the next block.
+    int used;               ///< Number of filled slots.
+    bool pooled;            ///< Owned by a graph's block arena, not freed with the list.
+
+    BasicBlock(BasicBlock* n = nullptr) : next(n), used(0), pooled(false) {}
 };
-class AdjacencyList {
+
+/**
+ * @struct IndexEntry
+ * @brief Hash index record for one destination of a high-degree list.
+ */
+template <typename V, typename W>
+struct IndexEntry {
+    BasicBlock<V, W>* block; ///< Block holding this destination.
+    int slot;     ///< Slot of the destination inside the block.
+    int copies;   ///< Number of parallel edges to this destination.
+};
+
+/**
+ * @struct DenseRow
+ * @brief Bitmap adjacency row with a weight per possible destination.
+ */
+template <typename W>
+struct DenseRow {
+    unsigned long long* bits;   ///< One bit per vertex of the graph.
+    W* weights;                 ///< Weight per vertex, valid where the bit is set (nullptr if unweighted).
+
+    DenseRow(long long universe) {
+        long long words = (universe + 63) / 64;
+        bits = new unsigned long long[words];
+        weights = isWeighted<W> ? new W[universe] : nullptr;
+        for (long long i = 0; i < words; ++i) bits[i] = 0;
+    }
+
+    ~DenseRow() {
+        delete[] bits;
+        delete[] weights;
+    }
+
+    bool test(unsigned long long v) const { return (bits[v / 64] >> (v % 64)) & 1; }
+    void set(unsigned long long v) { bits[v / 64] |= 1ULL << (v % 64); }
+    void clear(unsigned long long v) { bits[v / 64] &= ~(1ULL << (v % 64)); }
+};
+
+/**
+ * @struct StoragePolicy
+ * @brief Degree thresholds at which an adjacency list changes encoding.
+ *
+ * Each list keeps its first few edges inline, spills to an unrolled block
+ * list, attaches a hash index once its degree exceeds hashThreshold, and
+ * switches to a dense bitmap row once
+ * its degree reaches denseRatio of the vertex count. Weighted rows raise
+ * both dense ratios so a dense row never takes more memory than the block
+ * list it replaces. Each step is undone
+ * when the degree falls below the matching release threshold, so vertices
+ * near a boundary do not flip back and forth.
+ */
+struct StoragePolicy {
+    int hashThreshold;         ///< Degree above which a hash index is attached.
+    int hashRelease;           ///< Degree below which the hash index is dropped.
+    int denseMinVertices;      ///< Smallest graph in which dense rows are used.
+    double denseRatio;         ///< Degree / vertex count at which an unweighted row turns dense.
+    double denseReleaseRatio;  ///< Degree / vertex count below which it turns back.
+
+    StoragePolicy();
+};
+
+/**
+ * @struct StorageContext
+ * @brief Settings shared by all adjacency lists of one graph.
+ */
+struct StorageContext {
+    StoragePolicy policy;   ///< Encoding thresholds.
+    long long universe;     ///< Number of vertices a destination may refer to.
+};
+
+/**
+ * @class BasicAdjacencyList
+ * @brief Neighbor storage of one vertex.
+ * @tparam V Vertex ID type.
+ * @tparam W Weight type.
+ */
+template <typename V, typename W>
+class BasicAdjacencyList {
+public:
+    typedef V vertex_type;          ///< Vertex ID type.
+    typedef W weight_type;          ///< Weight type.
+    typedef BasicBlock<V, W> Block; ///< Block of the unrolled list.
+
+    /// Whether the list stores weights (false for Unweighted).
+    static constexpr bool WEIGHTED = isWeighted<W>;
+
+    /// Edges stored inside the list object before spilling to heap blocks.
+    static constexpr int INLINE_CAPACITY = 4;
+    /// Degree at which a spilled list moves back inline.
+    static constexpr int INLINE_RELEASE = INLINE_CAPACITY / 2;
+
+    /// Encodings an adjacency list can be in.
+    enum class Encoding {
+        INLINE,  ///< Up to INLINE_CAPACITY edges inside the list object.
+        LIST,    ///< Unrolled block list.
+        HASHED,  ///< Unrolled block list with a destination hash index.
+        DENSE    ///< Bitmap row over all vertices.
+    };
+
 private:
-    Node* head;  ///< Pointer to the first node (start of the list).
+    typedef IndexEntry<V, W> Entry;
+
+    /// Heap-backed storage, used once the list has spilled.
+    struct Spill {
+        Block* head;  ///< First block, the only one that may be partially filled.
+        HashIndex<V, Entry>* index; ///< Destination index, only for high-degree lists.
+        DenseRow<W>* dense;         ///< Bitmap row, replaces the blocks when set.
+        V parallel;   ///< Edges whose destination already had an edge (tracked while indexed).
+    };
+    /// Edges stored in place, newest last.
+    struct Local {
+        V dest[INLINE_CAPACITY];    ///< Destination vertices.
+        W weight[INLINE_CAPACITY];  ///< Weights, parallel to dest.
+    };
+
+    union {
+        Spill spill;  ///< Valid when spilled is true.
+        Local local;  ///< Valid when spilled is false.
+    };
+    const StorageContext* context; ///< Shared thresholds and vertex count.
+    V degree;     ///< Number of edges in the list.
+    bool spilled; ///< Whether edges live in heap storage rather than inline.
+
+    template <typename Visitor>
+    void forEachEdge(Visitor visit) const;
+    void spillLocal();
+    void unspill();
+    void append(V dest, W weight);
+    void buildIndex();
+    void dropIndex();
+    void toDense();
+    void toList();
+    double denseScale() const;
+    bool wantsDense() const;
+    void adapt();
+    static void release(Block* block);
+    bool locate(V dest, Block*& block, int& slot) const;
+    bool find(V dest, Block*& block, int& slot) const;
+    void removeAt(Block* block, int slot);
 
 public:
-    AdjacencyList();  ///< Constructor
-    ~AdjacencyList();  ///< Destructor
-    
-    void addEdge(int dest, int weight);   
-    void removeEdge(int dest);            
-    bool contains(int dest) const;       
+    /// Default degree above which a hash index is attached to the list.
+    static constexpr int HASH_INDEX_THRESHOLD = 32;
+    /// Default degree below which an attached index is dropped again.
+    static constexpr int HASH_INDEX_RELEASE = HASH_INDEX_THRESHOLD / 2;
+
+    BasicAdjacencyList();  ///< Constructor
+    ~BasicAdjacencyList();  ///< Destructor
+
+    void configure(const StorageContext* shared);
+    static V blocksFor(V count);
+    void place(V at, V dest, W weight, Block* blocks);
+    void adopt(Block* blocks, V count);
+    void addEdge(V dest, W weight);
+    void addEdges(const V* dests, const W* weights, V count);
+    void removeEdge(V dest);
+    V removeEdges(const V* dests, V count);
+    bool contains(V dest) const;
     void print() const;
-    int count() const;
-    int* getAllNeighbors() const;
-    int getWeight(int dest) const;
-    Node* getHead() const {return head;}
+    void print(OutputBuffer& out) const;
+    V count() const;
+    V* getAllNeighbors() const;
+    W* getAllWeights() const;
+    WeightResult<W> getWeight(V dest) const;
+    Block* getHead() const {return spilled ? spill.head : nullptr;}
+    bool isIndexed() const {return spilled && spill.index != nullptr;}
+    Encoding encoding() const;
+
 
-                   
 };
 
+/// Block and adjacency list with int vertex IDs and int weights.
+typedef BasicBlock<int, int> Block;
+typedef BasicAdjacencyList<int, int> AdjacencyList;
+
 }
 
 #endif
@@ -3,43 +3,81 @@
 #include "Algorithms.hpp"
 #include "Graph.hpp"
 #include "DataStructures.hpp"
+#include "CompressedGraph.hpp"
+#include "ConcurrentGraph.hpp"
+#include "DeltaGraph.hpp"
+#include "DenseGraph.hpp"
+#include "EdgeTableGraph.hpp"
+#include "PCSRGraph.hpp"
+#include "Snapshot.hpp"
+#include "WorkPool.hpp"
+#include <atomic>
+#include <stdexcept>
 
 namespace graph {
 
+/**
+ * @brief Weight of the i-th edge in a getNeighborWeights() array.
+ *
+ * Unweighted graphs return no array; each of their edges weighs 1.
+ */
+template <typename W, typename V>
+static W weightAt(const W* weights, V i) {
+    if constexpr (isWeighted<W>) {
+        return weights[i];
+    } else {
+        return W();
+    }
+}
+
+/// Spanning trees are only defined on undirected graphs.
+template <typename G>
+static void requireUndirected(const G& g) {
+    if (g.direction() == Direction::DIRECTED) {
+        throw std::invalid_argument("Spanning trees need an undirected graph");
+    }
+}
+
 /**
  * @brief Breadth-First Search (BFS).
  * 
  * Constructs a BFS tree starting from a given vertex.
  * @param g Input graph.
  * @param start Starting vertex.
- * @return Graph representing the BFS tree.
+ * @return Tree representing the BFS tree.
  */
-Graph Algorithms::bfs(const Graph& g, int start) {
-    int n = g.getNumVertices();
-    Graph tree(n);
+template <typename G>
+TreeOf<G> Algorithms::bfs(const G& g, typename G::vertex_type start) {
+    typedef typename G::vertex_type V;
+    typedef typename G::weight_type W;
+    V n = g.getNumVertices();
+    TreeOf<G> tree(n, g.direction());
+    if (!inRange(start, n)) return tree;
 
     bool* visited = new bool[n];     ///< Track visited vertices.
-    for (int i = 0; i < n; ++i) visited[i] = false;
+    for (V i = 0; i < n; ++i) visited[i] = false;
 
-    Queue q(n);
+    Queue<V> q(n);
     visited[start] = true;
     q.enqueue(start);
 
     while (!q.isEmpty()) {
-        int u = q.dequeue();
+        V u = q.dequeue();
 
-        int neighborCount = g.getNeighborCount(u);
-        int* neighbors = g.getNeighbors(u);
+        V neighborCount = g.getNeighborCount(u);
+        V* neighbors = g.getNeighbors(u);
+        W* weights = g.getNeighborWeights(u);
 
-        for (int i = 0; i < neighborCount; ++i) {
-            int v = neighbors[i];
+        for (V i = 0; i < neighborCount; ++i) {
+            V v = neighbors[i];
             if (!visited[v]) {
                 visited[v] = true;
-                tree.addEdge(u, v, g.getEdgeWeight(u, v)); ///< Record BFS tree edge.
+                tree.addEdge(u, v, weightAt(weights, i)); ///< Record BFS tree edge.
                 q.enqueue(v);
             }
         }
         delete[] neighbors;
+        delete[] weights;
     }
 
     delete[] visited;
@@ -53,19 +91,23 @@ Graph Algorithms::bfs(const Graph& g, int start) {
  * @param visited Boolean array tracking visited vertices.
  * @param tree Graph representing the DFS tree being built.
  */
-void dfsHelper(const Graph& g, int u, bool* visited, Graph& tree) {
+template <typename G>
+void dfsHelper(const G& g, typename G::vertex_type u, bool* visited, TreeOf<G>& tree) {
+    typedef typename G::vertex_type V;
     visited[u] = true;
-    int count = g.getNeighborCount(u);
-    int* neighbors = g.getNeighbors(u);
+    V count = g.getNeighborCount(u);
+    V* neighbors = g.getNeighbors(u);
+    typename G::weight_type* weights = g.getNeighborWeights(u);
 
-    for (int i = 0; i < count; ++i) {
-        int v = neighbors[i];
+    for (V i = 0; i < count; ++i) {
+        V v = neighbors[i];
         if (!visited[v]) {
-            tree.addEdge(u, v, g.getEdgeWeight(u, v)); ///< Record DFS tree edge.
+            tree.addEdge(u, v, weightAt(weights, i)); ///< Record DFS tree edge.
             dfsHelper(g, v, visited, tree);
         }
     }
     delete[] neighbors;
+    delete[] weights;
 }
 
 /**
@@ -76,11 +118,14 @@ void dfsHelper(const Graph& g, int u, bool* visited, Graph& tree) {
  * @param start Starting vertex.
  * @return Graph representing the DFS tree.
  */
-Graph Algorithms::dfs(const Graph& g, int start) {
-    int n = g.getNumVertices();
-    Graph tree(n);
+template <typename G>
+TreeOf<G> Algorithms::dfs(const G& g, typename G::vertex_type start) {
+    typedef typename G::vertex_type V;
+    V n = g.getNumVertices();
+    TreeOf<G> tree(n, g.direction());
+    if (!inRange(start, n)) return tree;
     bool* visited = new bool[n];
-    for (int i = 0; i < n; ++i) visited[i] = false;
+    for (V i = 0; i < n; ++i) visited[i] = false;
 
     dfsHelper(g, start, visited, tree);
 
@@ -92,59 +137,76 @@ Graph Algorithms::dfs(const Graph& g, int start) {
  * @brief Dijkstra's algorithm.
  * 
  * Computes shortest paths from a start vertex to all others.
- * Returns a shortest-path tree.
+ * Returns a shortest-path tree. Distances are accumulated in
+ * DistanceOf<W>, so long paths do not overflow narrow weight types.
+ * On unweighted graphs the BFS tree is already a shortest-path tree, so
+ * this is a plain BFS.
  * @param g Input weighted graph.
  * @param start Source vertex.
  * @return Graph representing the shortest-path tree.
  */
-Graph Algorithms::dijkstra(const Graph& g, int start) {
-    int n = g.getNumVertices();
-    Graph tree(n);
-
-    bool* visited = new bool[n];
-    int* dist = new int[n];   ///< Distance estimates.
-    int* prev = new int[n];   ///< Predecessor array.
-
-    for (int i = 0; i < n; ++i) {
-        visited[i] = false;
-        dist[i] = 1e9;        ///< Initialize with "infinity".
-        prev[i] = -1;
-    }
-    dist[start] = 0;
-
-    PriorityQueue pq(n);
-    pq.insert(start, 0);
-
-    while (!pq.isEmpty()) {
-        int u = pq.extractMin();
-        if (visited[u]) continue;
-        visited[u] = true;
-
-        int count = g.getNeighborCount(u);
-        int* neighbors = g.getNeighbors(u);
-
-        for (int i = 0; i < count; ++i) {
-            int v = neighbors[i];
-            int w = g.getEdgeWeight(u, v);
-            if (dist[v] > dist[u] + w) {
-                dist[v] = dist[u] + w;
-                prev[v] = u;
-                pq.insert(v, dist[v]);
+template <typename G>
+TreeOf<G> Algorithms::dijkstra(const G& g, typename G::vertex_type start) {
+    typedef typename G::vertex_type V;
+    typedef typename G::weight_type W;
+    typedef DistanceOf<W> D;
+    if constexpr (!isWeighted<W>) {
+        return bfs(g, start);
+    } else {
+        V n = g.getNumVertices();
+        TreeOf<G> tree(n, g.direction());
+        if (!inRange(start, n)) return tree;
+
+        bool* visited = new bool[n];
+        D* dist = new D[n];       ///< Distance estimates.
+        V* prev = new V[n];       ///< Predecessor array.
+        W* prevWeight = new W[n]; ///< Weight of the edge to the predecessor.
+
+        for (V i = 0; i < n; ++i) {
+            visited[i] = false;
+            dist[i] = infinity<D>();  ///< Initialize with "infinity".
+            prev[i] = none<V>();
+        }
+        dist[start] = 0;
+
+        PriorityQueue<V, D> pq(n);
+        pq.insert(start, 0);
+
+        while (!pq.isEmpty()) {
+            V u = pq.extractMin();
+            if (visited[u]) continue;
+            visited[u] = true;
+
+            V count = g.getNeighborCount(u);
+            V* neighbors = g.getNeighbors(u);
+            W* weights = g.getNeighborWeights(u);
+
+            for (V i = 0; i < count; ++i) {
+                V v = neighbors[i];
+                W w = weights[i];
+                if (dist[v] > dist[u] + w) {
+                    dist[v] = dist[u] + w;
+                    prev[v] = u;
+                    prevWeight[v] = w;
+                    pq.insert(v, dist[v]);
+                }
             }
+            delete[] neighbors;
+            delete[] weights;
         }
-        delete[] neighbors;
-    }
 
-    // Build shortest-path tree
-    for (int v = 0; v < n; ++v) {
-        if (prev[v] != -1)
-            tree.addEdge(v, prev[v], g.getEdgeWeight(v, prev[v]));
-    }
+        // Build shortest-path tree
+        for (V v = 0; v < n; ++v) {
+            if (prev[v] != none<V>())
+                tree.addEdge(prev[v], v, prevWeight[v]);   ///< Parent to child, for directed trees.
+        }
 
-    delete[] visited;
-    delete[] dist;
-    delete[] prev;
-    return tree;
+        delete[] visited;
+        delete[] dist;
+        delete[] prev;
+        delete[] prevWeight;
+        return tree;
+    }
 }
 
 /**
@@ -153,54 +215,67 @@ Graph Algorithms::dijkstra(const Graph& g, int start) {
  * Computes a Minimum Spanning Tree (MST).
  * @param g Input weighted graph.
  * @return Graph representing the MST.
+ * @throws std::invalid_argument If the graph is directed.
  */
-Graph Algorithms::prim(const Graph& g) {
-    int n = g.getNumVertices();
-    Graph tree(n);
-
-    bool* inMST = new bool[n];
-    int* key = new int[n];     ///< Minimum edge weight to connect a vertex.
-    int* parent = new int[n];  ///< Store MST parent.
-
-    for (int i = 0; i < n; ++i) {
-        inMST[i] = false;
-        key[i] = 1e9;
-        parent[i] = -1;
-    }
-
-    key[0] = 0;
-    PriorityQueue pq(n);
-    pq.insert(0, 0);
-
-    while (!pq.isEmpty()) {
-        int u = pq.extractMin();
-        inMST[u] = true;
-
-        int count = g.getNeighborCount(u);
-        int* neighbors = g.getNeighbors(u);
+template <typename G>
+TreeOf<G> Algorithms::prim(const G& g) {
+    typedef typename G::vertex_type V;
+    typedef typename G::weight_type W;
+    typedef DistanceOf<W> D;
+    requireUndirected(g);
+    if constexpr (!isWeighted<W>) {
+        return bfs(g, 0);   ///< Any spanning tree is minimal.
+    } else {
+        V n = g.getNumVertices();
+        TreeOf<G> tree(n);
+        if (n == 0) return tree;
+
+        bool* inMST = new bool[n];
+        D* key = new D[n];         ///< Minimum edge weight to connect a vertex.
+        V* parent = new V[n];      ///< Store MST parent.
+
+        for (V i = 0; i < n; ++i) {
+            inMST[i] = false;
+            key[i] = infinity<D>();
+            parent[i] = none<V>();
+        }
 
-        for (int i = 0; i < count; ++i) {
-            int v = neighbors[i];
-            int w = g.getEdgeWeight(u, v);
-            if (!inMST[v] && w < key[v]) {
-                key[v] = w;
-                parent[v] = u;
-                pq.insert(v, key[v]);
+        key[0] = 0;
+        PriorityQueue<V, D> pq(n);
+        pq.insert(0, 0);
+
+        while (!pq.isEmpty()) {
+            V u = pq.extractMin();
+            inMST[u] = true;
+
+            V count = g.getNeighborCount(u);
+            V* neighbors = g.getNeighbors(u);
+            W* weights = g.getNeighborWeights(u);
+
+            for (V i = 0; i < count; ++i) {
+                V v = neighbors[i];
+                W w = weights[i];
+                if (!inMST[v] && w < key[v]) {
+                    key[v] = w;
+                    parent[v] = u;
+                    pq.insert(v, key[v]);
+                }
             }
+            delete[] neighbors;
+            delete[] weights;
         }
-        delete[] neighbors;
-    }
 
-    // Build MST edges
-    for (int i = 1; i < n; ++i) {
-        if (parent[i] != -1)
-            tree.addEdge(i, parent[i], g.getEdgeWeight(i, parent[i]));
-    }
+        // Build MST edges
+        for (V i = 1; i < n; ++i) {
+            if (parent[i] != none<V>())
+                tree.addEdge(i, parent[i], static_cast<W>(key[i]));
+        }
 
-    delete[] inMST;
-    delete[] key;
-    delete[] parent;
-    return tree;
+        delete[] inMST;
+        delete[] key;
+        delete[] parent;
+        return tree;
+    }
 }
 
 /**
@@ -209,36 +284,61 @@ Graph Algorithms::prim(const Graph& g) {
  * Computes a Minimum Spanning Tree (MST) using Union-Find.
  * @param g Input weighted graph.
  * @return Graph representing the MST.
+ * @throws std::invalid_argument If the graph is directed.
  */
-Graph Algorithms::kruskal(const Graph& g) {
-    int n = g.getNumVertices();
-    Graph tree(n);
-    unionFind uf(n);
+template <typename G>
+TreeOf<G> Algorithms::kruskal(const G& g) {
+    typedef typename G::vertex_type V;
+    typedef typename G::weight_type W;
+    requireUndirected(g);
+    V n = g.getNumVertices();
+    TreeOf<G> tree(n);
+    unionFind<V> uf(n);
+
+    if constexpr (!isWeighted<W>) {
+        // Every spanning forest is minimal: join edges in adjacency order, no sorting.
+        for (V u = 0; u < n; ++u) {
+            V count = g.getNeighborCount(u);
+            V* neighbors = g.getNeighbors(u);
+            for (V i = 0; i < count; ++i) {
+                V v = neighbors[i];
+                if (uf.find(u) != uf.find(v)) {
+                    tree.addEdge(u, v);
+                    uf.unite(u, v);
+                }
+            }
+            delete[] neighbors;
+        }
+        return tree;
+    }
 
     struct Edge {
-        int u, v, w;
+        V u, v;
+        W w;
     };
 
-    Edge* edges = new Edge[n * n]; ///< Collect edges.
-    int edgeCount = 0;
+    Edge* edges = new Edge[g.countEdges()]; ///< Collect edges.
+    long long edgeCount = 0;
 
     // Collect all edges without duplicates
-    for (int u = 0; u < n; ++u) {
-        int count = g.getNeighborCount(u);
-        int* neighbors = g.getNeighbors(u);
+    for (V u = 0; u < n; ++u) {
+        V count = g.getNeighborCount(u);
+        V* neighbors = g.getNeighbors(u);
+        W* weights = g.getNeighborWeights(u);
 
-        for (int i = 0; i < count; ++i) {
-            int v = neighbors[i];
+        for (V i = 0; i < count; ++i) {
+            V v = neighbors[i];
             if (u < v) { // avoid duplicates
-                edges[edgeCount++] = {u, v, g.getEdgeWeight(u, v)};
+                edges[edgeCount++] = {u, v, weights[i]};
             }
         }
         delete[] neighbors;
+        delete[] weights;
     }
 
     // Sort edges by weight (bubble sort for simplicity)
-    for (int i = 0; i < edgeCount - 1; ++i) {
-        for (int j = 0; j < edgeCount - i - 1; ++j) {
+    for (long long i = 0; i < edgeCount - 1; ++i) {
+        for (long long j = 0; j < edgeCount - i - 1; ++j) {
             if (edges[j].w > edges[j + 1].w) {
                 Edge temp = edges[j];
                 edges[j] = edges[j + 1];
@@ -248,9 +348,9 @@ Graph Algorithms::kruskal(const Graph& g) {
     }
 
     // Build MST
-    for (int i = 0; i < edgeCount; ++i) {
-        int u = edges[i].u;
-        int v = edges[i].v;
+    for (long long i = 0; i < edgeCount; ++i) {
+        V u = edges[i].u;
+        V v = edges[i].v;
         if (uf.find(u) != uf.find(v)) {
             tree.addEdge(u, v, edges[i].w);
             uf.unite(u, v);
@@ -261,4 +361,308 @@ Graph Algorithms::kruskal(const Graph& g) {
     return tree;
 }
 
+/// Cost (edges plus vertices) at which parallel algorithms stop splitting work.
+static const long long PARALLEL_GRAIN = 4096;
+/// Vertices a parallel BFS chunk collects before appending them to the next frontier.
+static const int FRONTIER_BATCH = 256;
+
+/**
+ * @brief Prefix sum of the out-degrees of some vertices, for edge-balanced chunking.
+ * @param g Input graph.
+ * @param vertices Vertices to count, or nullptr for 0 .. count - 1.
+ * @param count Number of vertices.
+ * @param costs Output, count + 1 entries.
+ */
+template <typename G>
+static void degreePrefix(const G& g, const typename G::vertex_type* vertices, long long count,
+                         long long* costs) {
+    costs[0] = 0;
+    for (long long i = 0; i < count; ++i) {
+        typename G::vertex_type v = vertices != nullptr ? vertices[i] : static_cast<typename G::vertex_type>(i);
+        costs[i + 1] = costs[i] + g.getNeighborCount(v);
+    }
+}
+
+/**
+ * @brief Root of a vertex in a concurrent union-find, halving the path on the way.
+ *
+ * Every parent is smaller than its child, so the root is the smallest
+ * vertex of the set and a halving CAS can only move a vertex closer to it.
+ */
+template <typename V>
+static V rootOf(std::atomic<V>* parent, V v) {
+    V p = parent[v].load(std::memory_order_acquire);
+    while (p != v) {
+        V grandparent = parent[p].load(std::memory_order_acquire);
+        if (grandparent != p) parent[v].compare_exchange_weak(p, grandparent, std::memory_order_acq_rel);
+        v = p;
+        p = parent[v].load(std::memory_order_acquire);
+    }
+    return v;
+}
+
+/// Join the sets of two vertices in a concurrent union-find, hooking the larger root under the smaller.
+template <typename V>
+static void link(std::atomic<V>* parent, V a, V b) {
+    for (;;) {
+        a = rootOf(parent, a);
+        b = rootOf(parent, b);
+        if (a == b) return;
+        if (a < b) {
+            V swap = a;
+            a = b;
+            b = swap;
+        }
+        V expected = a;
+        if (parent[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel)) return;
+    }
+}
+
+/**
+ * @brief Parallel Breadth-First Search.
+ *
+ * Expands one level at a time: the frontier is split into chunks of about
+ * equal edge counts, and each newly reached vertex is claimed by exactly
+ * one chunk. Every vertex ends up at the same depth as in bfs(), though
+ * its parent may be another vertex of the level above.
+ * @param g Input graph.
+ * @param start Starting vertex.
+ * @param pool Workers to run on.
+ * @return Tree representing the BFS tree.
+ */
+template <typename G>
+TreeOf<G> Algorithms::parallelBfs(const G& g, typename G::vertex_type start, WorkPool& pool) {
+    typedef typename G::vertex_type V;
+    typedef typename G::weight_type W;
+    V n = g.getNumVertices();
+    TreeOf<G> tree(n, g.direction());
+    if (!inRange(start, n)) return tree;
+
+    std::atomic<bool>* visited = new std::atomic<bool>[n];
+    for (V i = 0; i < n; ++i) visited[i].store(false, std::memory_order_relaxed);
+    V* parent = new V[n];
+    W* parentWeight = new W[n];
+    V* frontier = new V[n];
+    V* next = new V[n];
+    long long* costs = new long long[static_cast<long long>(n) + 1];
+    std::atomic<long long> nextSize(0);
+
+    visited[start].store(true, std::memory_order_relaxed);
+    frontier[0] = start;
+    long long size = 1;
+    while (size > 0) {
+        degreePrefix(g, frontier, size, costs);
+        nextSize.store(0, std::memory_order_relaxed);
+        pool.forEachChunk(size, costs, PARALLEL_GRAIN, [&](long long begin, long long end) {
+            V found[FRONTIER_BATCH];
+            int count = 0;
+            auto flush = [&]() {
+                long long at = nextSize.fetch_add(count, std::memory_order_relaxed);
+                for (int i = 0; i < count; ++i) next[at + i] = found[i];
+                count = 0;
+            };
+            for (long long i = begin; i < end; ++i) {
+                V u = frontier[i];
+                V neighborCount = g.getNeighborCount(u);
+                V* neighbors = g.getNeighbors(u);
+                W* weights = g.getNeighborWeights(u);
+                for (V j = 0; j < neighborCount; ++j) {
+                    V v = neighbors[j];
+                    if (visited[v].load(std::memory_order_relaxed) ||
+                        visited[v].exchange(true, std::memory_order_relaxed)) continue;
+                    parent[v] = u;                 ///< Only the claiming chunk writes v's slot.
+                    parentWeight[v] = weightAt(weights, j);
+                    found[count++] = v;
+                    if (count == FRONTIER_BATCH) flush();
+                }
+                delete[] neighbors;
+                delete[] weights;
+            }
+            if (count > 0) flush();
+        });
+
+        size = nextSize.load(std::memory_order_relaxed);
+        for (long long i = 0; i < size; ++i) {
+            V v = next[i];
+            tree.addEdge(parent[v], v, parentWeight[v]); ///< Record BFS tree edge.
+        }
+        V* swap = frontier;
+        frontier = next;
+        next = swap;
+    }
+
+    delete[] visited;
+    delete[] parent;
+    delete[] parentWeight;
+    delete[] frontier;
+    delete[] next;
+    delete[] costs;
+    return tree;
+}
+
+/**
+ * @brief Connected components, in parallel.
+ *
+ * Every edge is fed to a lock-free union-find; chunks hold about equal
+ * numbers of edges. A directed graph yields its weakly connected
+ * components.
+ * @param g Input graph.
+ * @param pool Workers to run on.
+ * @return Dynamically allocated array of n labels: the smallest vertex of
+ *         each vertex's component.
+ * @note Caller is responsible for freeing the array.
+ */
+template <typename G>
+typename G::vertex_type* Algorithms::connectedComponents(const G& g, WorkPool& pool) {
+    typedef typename G::vertex_type V;
+    V n = g.getNumVertices();
+    V* labels = new V[n];
+    std::atomic<V>* parent = new std::atomic<V>[n];
+    long long* costs = new long long[static_cast<long long>(n) + 1];
+
+    pool.forEachChunk(n, PARALLEL_GRAIN, [&](long long begin, long long end) {
+        for (long long v = begin; v < end; ++v) parent[v].store(static_cast<V>(v), std::memory_order_relaxed);
+    });
+    degreePrefix(g, static_cast<const V*>(nullptr), n, costs);
+    pool.forEachChunk(n, costs, PARALLEL_GRAIN, [&](long long begin, long long end) {
+        for (long long i = begin; i < end; ++i) {
+            V u = static_cast<V>(i);
+            V count = g.getNeighborCount(u);
+            V* neighbors = g.getNeighbors(u);
+            for (V j = 0; j < count; ++j) {
+                if (neighbors[j] != u) link(parent, u, neighbors[j]);
+            }
+            delete[] neighbors;
+        }
+    });
+    pool.forEachChunk(n, PARALLEL_GRAIN, [&](long long begin, long long end) {
+        for (long long v = begin; v < end; ++v) labels[v] = rootOf(parent, static_cast<V>(v));
+    });
+
+    delete[] parent;
+    delete[] costs;
+    return labels;
+}
+
+/**
+ * @brief Borůvka's algorithm, in parallel.
+ *
+ * Each round finds, in parallel, the cheapest edge leaving every vertex
+ * and then every component, adds those edges, and relabels the merged
+ * components. Ties are broken by endpoints, so the chosen edges never
+ * close a cycle. Takes O(log n) rounds.
+ * @param g Input weighted graph.
+ * @param pool Workers to run on.
+ * @return Graph representing the minimum spanning forest.
+ * @throws std::invalid_argument If the graph is directed.
+ */
+template <typename G>
+TreeOf<G> Algorithms::boruvka(const G& g, WorkPool& pool) {
+    typedef typename G::vertex_type V;
+    typedef typename G::weight_type W;
+    requireUndirected(g);
+    V n = g.getNumVertices();
+    TreeOf<G> tree(n);
+    if (n == 0) return tree;
+
+    V* component = new V[n];       ///< Representative of each vertex's component.
+    V* bestDest = new V[n];        ///< Far end of the cheapest edge leaving each vertex, or none.
+    W* bestWeight = new W[n];
+    std::atomic<V>* cheapest = new std::atomic<V>[n];   ///< Vertex holding each component's cheapest edge.
+    V* merged = new V[n];          ///< Root after this round, per root.
+    long long* costs = new long long[static_cast<long long>(n) + 1];
+    for (V v = 0; v < n; ++v) component[v] = v;
+    degreePrefix(g, static_cast<const V*>(nullptr), n, costs);
+
+    // Strict order on edges: weight, then lower endpoint, then higher endpoint.
+    auto lighter = [](W w1, V a1, V b1, W w2, V a2, V b2) {
+        if (w1 < w2 || w2 < w1) return w1 < w2;
+        V low1 = a1 < b1 ? a1 : b1, high1 = a1 < b1 ? b1 : a1;
+        V low2 = a2 < b2 ? a2 : b2, high2 = a2 < b2 ? b2 : a2;
+        return low1 < low2 || (low1 == low2 && high1 < high2);
+    };
+
+    unionFind<V> uf(n);
+    bool progress = true;
+    while (progress) {
+        pool.forEachChunk(n, PARALLEL_GRAIN, [&](long long begin, long long end) {
+            for (long long v = begin; v < end; ++v) cheapest[v].store(none<V>(), std::memory_order_relaxed);
+        });
+        pool.forEachChunk(n, costs, PARALLEL_GRAIN, [&](long long begin, long long end) {
+            for (long long i = begin; i < end; ++i) {
+                V u = static_cast<V>(i);
+                V count = g.getNeighborCount(u);
+                V* neighbors = g.getNeighbors(u);
+                W* weights = g.getNeighborWeights(u);
+                bestDest[u] = none<V>();
+                for (V j = 0; j < count; ++j) {
+                    V v = neighbors[j];
+                    W w = weightAt(weights, j);
+                    if (component[v] == component[u]) continue;
+                    if (bestDest[u] == none<V>() || lighter(w, u, v, bestWeight[u], u, bestDest[u])) {
+                        bestDest[u] = v;
+                        bestWeight[u] = w;
+                    }
+                }
+                delete[] neighbors;
+                delete[] weights;
+                if (bestDest[u] == none<V>()) continue;
+
+                std::atomic<V>& slot = cheapest[component[u]];
+                V held = slot.load(std::memory_order_acquire);
+                while ((held == none<V>() ||
+                        lighter(bestWeight[u], u, bestDest[u], bestWeight[held], held, bestDest[held])) &&
+                       !slot.compare_exchange_weak(held, u, std::memory_order_acq_rel)) {}
+            }
+        });
+
+        progress = false;
+        for (V c = 0; c < n; ++c) {
+            if (component[c] != c) continue;
+            V u = cheapest[c].load(std::memory_order_relaxed);
+            if (u == none<V>()) continue;
+            V v = bestDest[u];
+            if (uf.find(c) == uf.find(component[v])) continue;   ///< Both sides picked this edge.
+            tree.addEdge(u, v, bestWeight[u]);
+            uf.unite(c, component[v]);
+            progress = true;
+        }
+        for (V c = 0; c < n; ++c) {
+            if (component[c] == c) merged[c] = uf.find(c);
+        }
+        pool.forEachChunk(n, PARALLEL_GRAIN, [&](long long begin, long long end) {
+            for (long long v = begin; v < end; ++v) component[v] = merged[component[v]];
+        });
+    }
+
+    delete[] component;
+    delete[] bestDest;
+    delete[] bestWeight;
+    delete[] cheapest;
+    delete[] merged;
+    delete[] costs;
+    return tree;
+}
+
+/// Instantiate every algorithm for a graph type (variadic, so template-ids may contain commas).
+#define GRAPH_INSTANTIATE_ALGORITHMS(...) \
+    template TreeOf<__VA_ARGS__> Algorithms::bfs<__VA_ARGS__>(const __VA_ARGS__&, typename __VA_ARGS__::vertex_type); \
+    template TreeOf<__VA_ARGS__> Algorithms::dfs<__VA_ARGS__>(const __VA_ARGS__&, typename __VA_ARGS__::vertex_type); \
+    template TreeOf<__VA_ARGS__> Algorithms::dijkstra<__VA_ARGS__>(const __VA_ARGS__&, typename __VA_ARGS__::vertex_type); \
+    template TreeOf<__VA_ARGS__> Algorithms::prim<__VA_ARGS__>(const __VA_ARGS__&); \
+    template TreeOf<__VA_ARGS__> Algorithms::kruskal<__VA_ARGS__>(const __VA_ARGS__&); \
+    template TreeOf<__VA_ARGS__> Algorithms::parallelBfs<__VA_ARGS__>(const __VA_ARGS__&, typename __VA_ARGS__::vertex_type, WorkPool&); \
+    template typename __VA_ARGS__::vertex_type* Algorithms::connectedComponents<__VA_ARGS__>(const __VA_ARGS__&, WorkPool&); \
+    template TreeOf<__VA_ARGS__> Algorithms::boruvka<__VA_ARGS__>(const __VA_ARGS__&, WorkPool&);
+#define GRAPH_INSTANTIATE_BASIC_ALGORITHMS(V, W) GRAPH_INSTANTIATE_ALGORITHMS(BasicGraph<V, W>)
+
+GRAPH_FOR_EACH_TYPE_PAIR(GRAPH_INSTANTIATE_BASIC_ALGORITHMS)
+GRAPH_INSTANTIATE_ALGORITHMS(CompressedGraph)
+GRAPH_INSTANTIATE_ALGORITHMS(ConcurrentGraph::ReadView)
+GRAPH_INSTANTIATE_ALGORITHMS(DeltaGraph)
+GRAPH_INSTANTIATE_ALGORITHMS(DenseGraph)
+GRAPH_INSTANTIATE_ALGORITHMS(EdgeTableGraph)
+GRAPH_INSTANTIATE_ALGORITHMS(PCSRGraph)
+GRAPH_INSTANTIATE_ALGORITHMS(SnapshotGraph)
+
 } // namespace graph
@@ -6,17 +6,61 @@
 
 namespace graph {
 
+class WorkPool;
+
+/**
+ * @brief Graph type of the trees an algorithm builds from a graph of type G.
+ *
+ * Same vertex ID and weight types as the input graph.
+ */
+template <typename G>
+using TreeOf = BasicGraph<typename G::vertex_type, typename G::weight_type>;
+
+/**
+ * @class Algorithms
+ * @brief Graph algorithms, each returning its result tree as a BasicGraph.
+ *
+ * Every algorithm is a template over the input graph type, which must offer
+ * Graph's query API (getNumVertices, getNeighborCount, getNeighbors,
+ * getNeighborWeights, direction) and name its vertex_type and weight_type.
+ * They are instantiated in Algorithms.cpp for every BasicGraph type pair,
+ * CompressedGraph, ConcurrentGraph::ReadView, DeltaGraph, DenseGraph,
+ * EdgeTableGraph, PCSRGraph and SnapshotGraph.
+ *
+ * bfs, dfs and dijkstra follow out-edges, so on a directed graph they
+ * return a directed tree with arcs from parent to child. prim and kruskal
+ * need an undirected graph.
+ *
+ * parallelBfs, connectedComponents and boruvka spread their edge scans
+ * over a WorkPool in chunks of about equal edge counts. They call the
+ * graph's const queries from several threads at once, which every graph
+ * type above allows.
+ */
 class Algorithms {
 public:
-    static Graph bfs(const Graph& g, int start);
+    template <typename G>
+    static TreeOf<G> bfs(const G& g, typename G::vertex_type start);
+
+    template <typename G>
+    static TreeOf<G> dfs(const G& g, typename G::vertex_type start);
+
+    template <typename G>
+    static TreeOf<G> dijkstra(const G& g, typename G::vertex_type start);
+
+    template <typename G>
+    static TreeOf<G> prim(const G& g);
 
-    static Graph dfs(const Graph& g, int start);
+    template <typename G>
+    static TreeOf<G> kruskal(const G& g);
 
-    static Graph dijkstra(const Graph& g, int start);
+    template <typename G>
+    static TreeOf<G> parallelBfs(const G& g, typename G::vertex_type start, WorkPool& pool);
 
-    static Graph prim(const Graph& g);
+    template <typename G>
+    static typename G::vertex_type* connectedComponents(const G& g, WorkPool& pool);
 
-    static Graph kruskal(const Graph& g);
+    template <typename G>
+    static TreeOf<G> boruvka(const G& g, WorkPool& pool);
 };
 
 } 
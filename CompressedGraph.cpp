@@ -0,0 +1,396 @@
+// ronavraham99@gmail.com
+
+#include "CompressedGraph.hpp"
+#include "Dump.hpp"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace graph {
+
+/// Number of bytes needed to LEB128-encode a value.
+static int varintSize(unsigned int value) {
+    int size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+/// LEB128-encode a value, advancing the output pointer.
+static void writeVarint(unsigned char*& out, unsigned int value) {
+    while (value >= 0x80) {
+        *out++ = static_cast<unsigned char>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<unsigned char>(value);
+}
+
+/// Decode a LEB128 value, advancing the input pointer.
+static unsigned int readVarint(const unsigned char*& in) {
+    unsigned int value = 0;
+    int shift = 0;
+    while (*in & 0x80) {
+        value |= static_cast<unsigned int>(*in++ & 0x7F) << shift;
+        shift += 7;
+    }
+    value |= static_cast<unsigned int>(*in++) << shift;
+    return value;
+}
+
+/// Map signed weights to unsigned so small negatives stay short.
+static unsigned int zigzag(int value) {
+    return (static_cast<unsigned int>(value) << 1) ^ static_cast<unsigned int>(value >> 31);
+}
+
+static int unzigzag(unsigned int value) {
+    return static_cast<int>(value >> 1) ^ -static_cast<int>(value & 1);
+}
+
+/**
+ * @brief Sort a vertex's edges by destination, keeping weights aligned.
+ * @param neighbors Destination array, sorted in place.
+ * @param weights Weight array, permuted alongside.
+ * @param count Number of edges.
+ */
+static void sortEdges(int* neighbors, int* weights, int count) {
+    struct Edge {
+        int dest, weight;
+    };
+    Edge* edges = new Edge[count];
+    for (int i = 0; i < count; ++i) edges[i] = {neighbors[i], weights[i]};
+    std::sort(edges, edges + count, [](const Edge& a, const Edge& b) { return a.dest < b.dest; });
+    for (int i = 0; i < count; ++i) {
+        neighbors[i] = edges[i].dest;
+        weights[i] = edges[i].weight;
+    }
+    delete[] edges;
+}
+
+/**
+ * @brief Size of one vertex record.
+ * @param count Degree of the vertex.
+ * @param dest dest(i) is the i-th neighbor, in ascending order.
+ * @param weight weight(i) is the weight of the i-th edge.
+ */
+template <typename Dest, typename Weight>
+static long long recordSize(int count, Dest dest, Weight weight) {
+    long long size = varintSize(count);
+    int prev = 0;
+    for (int i = 0; i < count; ++i) {
+        size += varintSize(dest(i) - prev);   ///< Gap to the previous neighbor.
+        size += varintSize(zigzag(weight(i)));
+        prev = dest(i);
+    }
+    return size;
+}
+
+/// Encode one vertex record at out; arguments as for recordSize().
+template <typename Dest, typename Weight>
+static void writeRecord(unsigned char* out, int count, Dest dest, Weight weight) {
+    writeVarint(out, count);
+    int prev = 0;
+    for (int i = 0; i < count; ++i) {
+        writeVarint(out, dest(i) - prev);
+        prev = dest(i);
+    }
+    for (int i = 0; i < count; ++i) {
+        writeVarint(out, zigzag(weight(i)));
+    }
+}
+
+/**
+ * @brief Set up a graph with no rows encoded yet.
+ * @param vertices Number of vertices in the graph.
+ * @param direction Direction of the graph.
+ */
+void CompressedGraph::init(int vertices, Direction direction) {
+    num_of_vertices = vertices;
+    edge_direction = direction;
+    rows = 0;
+    data_capacity = 0;
+    data = nullptr;
+    offsets = new long long[num_of_vertices + 1];
+    offsets[0] = 0;
+}
+
+/**
+ * @brief Encode the next row at the end of the data, growing it as needed.
+ *
+ * The buffer doubles as it fills and is trimmed to its exact size once the
+ * last row is in.
+ * @param count Degree of the vertex; dest and weight as for recordSize().
+ */
+template <typename Dest, typename Weight>
+void CompressedGraph::encodeRow(int count, Dest dest, Weight weight) {
+    long long at = offsets[rows];
+    long long size = recordSize(count, dest, weight);
+    long long needed = at + size;
+    if (rows + 1 == num_of_vertices || needed > data_capacity) {
+        long long grown = rows + 1 == num_of_vertices ? needed : std::max(needed, 2 * data_capacity);
+        unsigned char* larger = new unsigned char[grown];
+        std::copy(data, data + at, larger);
+        delete[] data;
+        data = larger;
+        data_capacity = grown;
+    }
+    writeRecord(data + at, count, dest, weight);
+    offsets[++rows] = needed;
+}
+
+/**
+ * @brief Build a compressed copy of a graph.
+ *
+ * Each row is read, sorted and encoded once, straight into the data.
+ * @param g Graph to compress.
+ */
+CompressedGraph::CompressedGraph(const Graph& g) {
+    init(g.getNumVertices(), g.direction());
+    for (int v = 0; v < num_of_vertices; ++v) {
+        int count = g.getNeighborCount(v);
+        int* neighbors = g.getNeighbors(v);
+        int* weights = g.getNeighborWeights(v);
+        sortEdges(neighbors, weights, count);
+        encodeRow(count, [neighbors](int i) { return neighbors[i]; }, [weights](int i) { return weights[i]; });
+        delete[] neighbors;
+        delete[] weights;
+    }
+}
+
+/**
+ * @brief Encode a graph straight from its arcs, without building a Graph.
+ *
+ * Each row is a contiguous run of the list and is encoded in one pass.
+ * The whole list must be in memory (12 bytes per arc, both arcs of an
+ * undirected edge); a graph too large for that is built row by row with
+ * appendRow() instead.
+ * @param vertices Number of vertices in the graph.
+ * @param arcs Arcs sorted by source, then destination. An undirected graph
+ *        needs both arcs of every edge (a self-loop twice), as Graph stores them.
+ * @param count Number of arcs.
+ * @param direction Direction of the graph.
+ * @throws std::out_of_range If an arc refers to a vertex outside the graph.
+ * @throws std::invalid_argument If the arcs are not sorted.
+ */
+CompressedGraph::CompressedGraph(int vertices, const Graph::Edge* arcs, long long count, Direction direction) {
+    for (long long i = 0; i < count; ++i) {
+        if (arcs[i].src < 0 || arcs[i].dest < 0 || arcs[i].src >= vertices || arcs[i].dest >= vertices) {
+            throw std::out_of_range("Invalid edge in edge list");
+        }
+        if (i > 0 && (arcs[i].src < arcs[i - 1].src ||
+                      (arcs[i].src == arcs[i - 1].src && arcs[i].dest < arcs[i - 1].dest))) {
+            throw std::invalid_argument("Edge list is not sorted by source and destination");
+        }
+    }
+    init(vertices, direction);
+    long long next = 0;
+    for (int v = 0; v < num_of_vertices; ++v) {
+        const Graph::Edge* row = arcs + next;
+        int degree = 0;
+        while (next < count && arcs[next].src == v) {
+            ++next;
+            ++degree;
+        }
+        encodeRow(degree, [row](int i) { return row[i].dest; }, [row](int i) { return row[i].weight; });
+    }
+}
+
+/**
+ * @brief Construct a graph to be filled row by row with appendRow().
+ *
+ * Until its row is appended, a vertex has no neighbors.
+ * @param vertices Number of vertices in the graph.
+ * @param direction Direction of the graph.
+ */
+CompressedGraph::CompressedGraph(int vertices, Direction direction) {
+    init(vertices, direction);
+}
+
+/**
+ * @brief Encode the row of the next vertex, in vertex order from 0.
+ *
+ * Only the encoded rows and the caller's current row are in memory, so a
+ * graph can be built from a source far larger than RAM; an undirected
+ * graph needs every row complete, both arcs of each edge included.
+ * @param dests Neighbors of the vertex in ascending order.
+ * @param weights Weights, parallel to dests.
+ * @param count Degree of the vertex.
+ * @throws std::logic_error If every vertex already has its row.
+ * @throws std::out_of_range If a neighbor is outside the graph.
+ * @throws std::invalid_argument If the neighbors are not sorted.
+ */
+void CompressedGraph::appendRow(const int* dests, const int* weights, int count) {
+    if (rows == num_of_vertices) throw std::logic_error("Every row has already been appended");
+    for (int i = 0; i < count; ++i) {
+        if (dests[i] < 0 || dests[i] >= num_of_vertices) throw std::out_of_range("Invalid edge in row");
+        if (i > 0 && dests[i] < dests[i - 1]) throw std::invalid_argument("Row is not sorted by destination");
+    }
+    encodeRow(count, [dests](int i) { return dests[i]; }, [weights](int i) { return weights[i]; });
+}
+
+/// @return Number of rows encoded so far.
+int CompressedGraph::rowCount() const {
+    return rows;
+}
+
+/// Destructor – releases the encoded data.
+CompressedGraph::~CompressedGraph() {
+    delete[] offsets;
+    delete[] data;
+}
+
+/**
+ * @brief Locate a vertex record and decode its degree.
+ * @param vertex Vertex index (must be valid).
+ * @param degree Set to the vertex degree.
+ * @return Pointer to the first encoded neighbor gap.
+ */
+const unsigned char* CompressedGraph::record(int vertex, int& degree) const {
+    if (vertex >= rows) {       ///< Not appended yet.
+        degree = 0;
+        return nullptr;
+    }
+    const unsigned char* in = data + offsets[vertex];
+    degree = static_cast<int>(readVarint(in));
+    return in;
+}
+
+/**
+ * @brief Print the entire graph.
+ *
+ * Displays each vertex followed by its neighbors in ascending order.
+ */
+void CompressedGraph::print_graph() const {
+    OutputBuffer out(std::cout);
+    dump(*this, out);
+    out.flush();
+}
+
+/// @return Number of vertices in the graph.
+int CompressedGraph::getNumVertices() const {
+    return num_of_vertices;
+}
+
+/**
+ * @brief Get the number of neighbors for a given vertex.
+ * @param vertex Vertex index.
+ * @return Number of neighbors, or 0 if invalid vertex.
+ */
+int CompressedGraph::getNeighborCount(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return 0;
+    int degree;
+    record(vertex, degree);
+    return degree;
+}
+
+/**
+ * @brief Decode all neighbors of a vertex.
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of neighbors in ascending order, or nullptr if invalid.
+ * @note Caller is responsible for freeing the array.
+ */
+int* CompressedGraph::getNeighbors(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return nullptr;
+    int degree;
+    const unsigned char* in = record(vertex, degree);
+
+    int* neighbors = new int[degree];
+    int prev = 0;
+    for (int i = 0; i < degree; ++i) {
+        prev += static_cast<int>(readVarint(in));
+        neighbors[i] = prev;
+    }
+    return neighbors;
+}
+
+/**
+ * @brief Decode the weights of all edges leaving a vertex.
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of weights, parallel to getNeighbors(), or nullptr if invalid.
+ * @note Caller is responsible for freeing the array.
+ */
+int* CompressedGraph::getNeighborWeights(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return nullptr;
+    int degree;
+    const unsigned char* in = record(vertex, degree);
+
+    for (int i = 0; i < degree; ++i) readVarint(in);   ///< Skip the neighbor gaps.
+    int* weights = new int[degree];
+    for (int i = 0; i < degree; ++i) {
+        weights[i] = unzigzag(readVarint(in));
+    }
+    return weights;
+}
+
+/**
+ * @brief Get the weight of an edge between two vertices.
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @return Edge weight, or -1 if invalid or edge not found.
+ */
+int CompressedGraph::getEdgeWeight(int src, int dest) const {
+    if (src < 0 || dest < 0 || src >= num_of_vertices || dest >= num_of_vertices)
+        return -1;
+    int degree;
+    const unsigned char* in = record(src, degree);
+
+    int position = -1;
+    int prev = 0;
+    int i = 0;
+    for (; i < degree; ++i) {
+        prev += static_cast<int>(readVarint(in));
+        if (prev >= dest) {
+            if (prev == dest) position = i;
+            ++i;
+            break;      ///< Neighbors are sorted, no match past this point.
+        }
+    }
+    if (position < 0) return -1;
+
+    for (; i < degree; ++i) readVarint(in);
+    unsigned int encoded = 0;
+    for (int k = 0; k <= position; ++k) encoded = readVarint(in);
+    return unzigzag(encoded);
+}
+
+/**
+ * @brief Check if an edge exists between two vertices.
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @return True if the edge exists, false otherwise.
+ */
+bool CompressedGraph::containsEdge(int src, int dest) const {
+    if (src < 0 || dest < 0 || src >= num_of_vertices || dest >= num_of_vertices) {
+        return false;
+    }
+    int degree;
+    const unsigned char* in = record(src, degree);
+
+    int prev = 0;
+    for (int i = 0; i < degree; ++i) {
+        prev += static_cast<int>(readVarint(in));
+        if (prev >= dest) return prev == dest;
+    }
+    return false;
+}
+
+/**
+ * @brief Count the total number of edges in the graph.
+ * @return Number of undirected edges, or of arcs if the graph is directed.
+ */
+long long CompressedGraph::countEdges() const {
+    long long total = 0;
+    for (int v = 0; v < num_of_vertices; ++v) {
+        total += getNeighborCount(v);
+    }
+    if (edge_direction == Direction::DIRECTED) return total;
+    return total / 2; ///< Divide by 2 since the graph is undirected.
+}
+
+/// @return Memory used by the encoded adjacency, in bytes.
+long long CompressedGraph::sizeInBytes() const {
+    return offsets[rows] + (num_of_vertices + 1) * static_cast<long long>(sizeof(long long));
+}
+
+} // namespace graph
@@ -0,0 +1,70 @@
+// ronavraham99@gmail.com
+
+#ifndef COMPRESSED_GRAPH_HPP
+#define COMPRESSED_GRAPH_HPP
+
+#include "Graph.hpp"
+
+namespace graph {
+
+/**
+ * @class CompressedGraph
+ * @brief Read-only graph with delta/varint compressed adjacency.
+ *
+ * Each vertex owns one byte record: its degree, then its neighbor IDs in
+ * ascending order as gaps, then its edge weights zigzag-encoded, all as
+ * LEB128 variable-length integers. Typical sparse graphs take 2–3 bytes
+ * per stored edge instead of a full adjacency block slot.
+ *
+ * Built from a Graph, from a sorted arc list held in memory, or row by
+ * row with appendRow() on a graph constructed empty, which needs memory
+ * only for the encoded rows and the row being added, so the source can be
+ * far larger than RAM. Each row is encoded once. Offers the same query
+ * API as Graph, so Algorithms run on it directly, decoding neighbor lists
+ * on the fly.
+ */
+class CompressedGraph {
+public:
+    typedef int vertex_type;  ///< Vertex ID type.
+    typedef int weight_type;  ///< Weight type.
+
+private:
+    int num_of_vertices;      ///< Number of vertices in the graph.
+    long long* offsets;       ///< Start of each vertex record in data (num_of_vertices + 1 entries).
+    unsigned char* data;      ///< Concatenated vertex records.
+    long long data_capacity;  ///< Bytes allocated for data.
+    int rows;                 ///< Vertices whose record is encoded, from vertex 0 up.
+    Direction edge_direction; ///< Direction of the source graph.
+
+    void init(int vertices, Direction direction);
+    template <typename Dest, typename Weight>
+    void encodeRow(int count, Dest dest, Weight weight);
+    const unsigned char* record(int vertex, int& degree) const;
+
+public:
+    CompressedGraph(const Graph& g);
+    CompressedGraph(int vertices, const Graph::Edge* arcs, long long count,
+                    Direction direction = Direction::UNDIRECTED);
+    CompressedGraph(int vertices, Direction direction = Direction::UNDIRECTED);
+    ~CompressedGraph();
+    CompressedGraph(const CompressedGraph&) = delete;
+    CompressedGraph& operator=(const CompressedGraph&) = delete;
+
+    void appendRow(const int* dests, const int* weights, int count);
+    int rowCount() const;
+
+    void print_graph() const;
+    int getNumVertices() const;
+    int getNeighborCount(int vertex) const;
+    int* getNeighbors(int vertex) const;
+    int* getNeighborWeights(int vertex) const;
+    int getEdgeWeight(int src, int dest) const;
+    bool containsEdge(int src, int dest) const;
+    long long countEdges() const;
+    Direction direction() const {return edge_direction;}
+    long long sizeInBytes() const;
+};
+
+} // namespace graph
+
+#endif // COMPRESSED_GRAPH_HPP
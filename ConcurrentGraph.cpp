@@ -0,0 +1,749 @@
+// ronavraham99@gmail.com
+
+#include "ConcurrentGraph.hpp"
+#include "Dump.hpp"
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace graph {
+
+/// died of a live node; epoch of an idle slot.
+static const unsigned long long LIVE = std::numeric_limits<unsigned long long>::max();
+static const unsigned long long INACTIVE = LIVE;
+/// Removed nodes that make a writer run the reclaimer.
+static const int COLLECT_THRESHOLD = 1024;
+/// Most nodes the reclaimer puts in one free batch.
+static const int FREE_BATCH = 256;
+/// States of a reader slot.
+static const int IDLE = 0;
+static const int ENTERING = 1;
+static const int READING = 2;
+
+/**
+ * @brief Lock the stripes of two vertices, lower stripe first.
+ *
+ * Every writer locks in the same order, so no two can wait on each other.
+ */
+ConcurrentGraph::StripeGuard::StripeGuard(const ConcurrentGraph& g, int u, int v) {
+    int a = u & (g.stripe_count - 1);
+    int b = v & (g.stripe_count - 1);
+    if (b < a) {
+        int swap = a;
+        a = b;
+        b = swap;
+    }
+    first = &g.stripes[a];
+    second = a == b ? nullptr : &g.stripes[b];
+    first->lock.lock();
+    if (second != nullptr) second->lock.lock();
+}
+
+/// Unlock in reverse order.
+ConcurrentGraph::StripeGuard::~StripeGuard() {
+    if (second != nullptr) second->lock.unlock();
+    first->lock.unlock();
+}
+
+/**
+ * @brief Open a view of every update finished so far.
+ *
+ * The slot first announces ENTERING, which stops the reclaimer from
+ * unlinking anything, and only then copies the writer slots' progress; so
+ * a reclaimer that missed the announcement has already finished with
+ * every node this view could need. The epoch is announced before any list
+ * is read.
+ */
+ConcurrentGraph::ReadView::ReadView(const ConcurrentGraph& g) : graph(g), slot(nullptr) {
+    int count = g.reader_count;
+    int start = static_cast<int>(std::hash<std::thread::id>()(std::this_thread::get_id()) % count);
+    while (slot == nullptr) {
+        for (int i = 0; i < count && slot == nullptr; ++i) {
+            ReaderSlot& candidate = g.readers[(start + i) % count];
+            bool expected = false;
+            if (!candidate.busy.load(std::memory_order_relaxed) &&
+                candidate.busy.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                slot = &candidate;
+            }
+        }
+        if (slot == nullptr) std::this_thread::yield();
+    }
+    slot->state.store(ENTERING);
+    g.announceEpoch(slot->epoch);
+    g.snapshot(seen);
+    for (int w = 0; w < WRITER_SLOTS; ++w) slot->seen[w].store(seen[w]);
+    slot->state.store(READING);
+}
+
+/// Release the reader slot.
+ConcurrentGraph::ReadView::~ReadView() {
+    slot->state.store(IDLE);
+    slot->epoch.store(INACTIVE);
+    slot->busy.store(false, std::memory_order_release);
+}
+
+/// @return Number of vertices in the graph.
+int ConcurrentGraph::ReadView::getNumVertices() const {
+    return graph.num_of_vertices;
+}
+
+/**
+ * @brief Get the number of neighbors of a vertex in this view.
+ * @param vertex Vertex index.
+ * @return Number of neighbors, or 0 if invalid vertex.
+ */
+int ConcurrentGraph::ReadView::getNeighborCount(int vertex) const {
+    int count = 0;
+    forEachNeighbor(vertex, [&count](int, int) { count++; });
+    return count;
+}
+
+/**
+ * @brief Get all neighbors of a vertex in this view, newest first.
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of getNeighborCount(vertex) neighbors, or nullptr if invalid.
+ * @note Caller is responsible for freeing the array.
+ */
+int* ConcurrentGraph::ReadView::getNeighbors(int vertex) const {
+    if (vertex < 0 || vertex >= graph.num_of_vertices) return nullptr;
+    int* neighbors = new int[getNeighborCount(vertex)];
+    int count = 0;
+    forEachNeighbor(vertex, [neighbors, &count](int dest, int) { neighbors[count++] = dest; });
+    return neighbors;
+}
+
+/**
+ * @brief Get the weights of the edges of a vertex in this view.
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of weights, parallel to getNeighbors(), or nullptr if invalid.
+ * @note Caller is responsible for freeing the array.
+ */
+int* ConcurrentGraph::ReadView::getNeighborWeights(int vertex) const {
+    if (vertex < 0 || vertex >= graph.num_of_vertices) return nullptr;
+    int* weights = new int[getNeighborCount(vertex)];
+    int count = 0;
+    forEachNeighbor(vertex, [weights, &count](int, int weight) { weights[count++] = weight; });
+    return weights;
+}
+
+/**
+ * @brief Get the weight of an edge in this view.
+ *
+ * Of parallel copies, the one with the highest stamp counts, which is the
+ * same copy in both lists of an undirected edge.
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @return Weight of that copy of the edge, or -1 if invalid or edge not found.
+ */
+int ConcurrentGraph::ReadView::getEdgeWeight(int src, int dest) const {
+    if (!graph.isValid(src, dest)) return -1;
+    const Node* best = nullptr;
+    for (const Node* node = graph.rows[src].head.load(std::memory_order_acquire); node != nullptr;
+         node = node->next.load(std::memory_order_acquire)) {
+        if (node->dest == dest && visible(node) && (best == nullptr || node->born > best->born)) best = node;
+    }
+    return best == nullptr ? -1 : best->weight;
+}
+
+/**
+ * @brief Check if an edge exists in this view.
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @return True if the edge exists, false otherwise.
+ */
+bool ConcurrentGraph::ReadView::containsEdge(int src, int dest) const {
+    if (!graph.isValid(src, dest)) return false;
+    bool found = false;
+    forEachNeighbor(src, [dest, &found](int to, int) { found = found || to == dest; });
+    return found;
+}
+
+/**
+ * @brief Count the edges in this view by walking every list.
+ * @return Number of edges (arcs if directed).
+ */
+long long ConcurrentGraph::ReadView::countEdges() const {
+    long long total = 0;
+    for (int v = 0; v < graph.num_of_vertices; ++v) total += getNeighborCount(v);
+    if (graph.edge_direction == Direction::DIRECTED) return total;
+    return total / 2; ///< Divide by 2 since the graph is undirected.
+}
+
+/**
+ * @brief Construct an empty concurrent graph.
+ * @param vertices Number of vertices in the graph.
+ * @param direction Whether edges are stored in both directions.
+ * @param stripes Number of writer locks, rounded up to a power of two.
+ *        More stripes let more removals run at once.
+ * @param readers Number of ReadViews that can be open at once.
+ */
+ConcurrentGraph::ConcurrentGraph(int vertices, Direction direction, int stripes, int readers)
+    : num_of_vertices(vertices), edge_direction(direction),
+      completed(0), reader_count(readers < 1 ? 1 : readers), chunks(nullptr), free_batches(nullptr),
+      dead(nullptr), dead_size(0), dead_capacity(0), epoch(1), limbo(nullptr) {
+    stripe_count = 1;
+    while (stripe_count < stripes) stripe_count *= 2;
+    this->stripes = new Stripe[stripe_count];
+    writers = new WriterSlot[WRITER_SLOTS];
+    for (int w = 0; w < WRITER_SLOTS; ++w) {
+        writers[w].busy.store(false, std::memory_order_relaxed);
+        writers[w].done.store(0, std::memory_order_relaxed);
+        writers[w].epoch.store(INACTIVE, std::memory_order_relaxed);
+        writers[w].sequence = 0;
+        writers[w].free = nullptr;
+        writers[w].fresh = nullptr;
+        writers[w].fresh_left = 0;
+    }
+    this->readers = new ReaderSlot[reader_count];
+    for (int i = 0; i < reader_count; ++i) {
+        this->readers[i].busy.store(false, std::memory_order_relaxed);
+        this->readers[i].state.store(IDLE, std::memory_order_relaxed);
+        this->readers[i].epoch.store(INACTIVE, std::memory_order_relaxed);
+        for (int w = 0; w < WRITER_SLOTS; ++w) this->readers[i].seen[w].store(0, std::memory_order_relaxed);
+    }
+    rows = new Row[vertices];
+    for (int v = 0; v < vertices; ++v) {
+        rows[v].head.store(nullptr, std::memory_order_relaxed);
+        rows[v].degree.store(0, std::memory_order_relaxed);
+    }
+}
+
+/// Destructor – frees every chunk, and with them every node.
+ConcurrentGraph::~ConcurrentGraph() {
+    Chunk* chunk = chunks.load(std::memory_order_acquire);
+    while (chunk != nullptr) {
+        Chunk* next = chunk->next;
+        delete chunk;
+        chunk = next;
+    }
+    delete[] dead;
+    delete[] readers;
+    delete[] writers;
+    delete[] rows;
+    delete[] stripes;
+}
+
+/// @return True if both endpoints are valid vertices.
+bool ConcurrentGraph::isValid(int src, int dest) const {
+    return src >= 0 && dest >= 0 && src < num_of_vertices && dest < num_of_vertices;
+}
+
+/**
+ * @brief Claim a free writer slot, starting from one picked by thread id.
+ *
+ * Waits only while all WRITER_SLOTS updates are running.
+ * @return Index of the slot.
+ */
+int ConcurrentGraph::acquireWriter() {
+    int start = static_cast<int>(std::hash<std::thread::id>()(std::this_thread::get_id()) % WRITER_SLOTS);
+    for (;;) {
+        for (int i = 0; i < WRITER_SLOTS; ++i) {
+            int slot = (start + i) % WRITER_SLOTS;
+            bool expected = false;
+            if (!writers[slot].busy.load(std::memory_order_relaxed) &&
+                writers[slot].busy.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return slot;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+/// Hand a writer slot, node cache included, to the next update.
+void ConcurrentGraph::releaseWriter(int slot) {
+    writers[slot].busy.store(false, std::memory_order_release);
+}
+
+/// Publish the update a writer slot just finished.
+void ConcurrentGraph::finish(WriterSlot& writer) {
+    writer.done.store(writer.sequence);
+    completed.fetch_add(1);
+}
+
+/**
+ * @brief Copy how many updates each writer slot has finished.
+ *
+ * Works like a seqlock read: the copy is repeated until no update finished
+ * during it, so it never holds a later update without an earlier one that
+ * finished before the later one started.
+ */
+void ConcurrentGraph::snapshot(unsigned long long* seen) const {
+    unsigned long long before = completed.load();
+    for (;;) {
+        for (int w = 0; w < WRITER_SLOTS; ++w) seen[w] = writers[w].done.load();
+        unsigned long long after = completed.load();
+        if (after == before) return;
+        before = after;
+    }
+}
+
+/**
+ * @brief Announce the current epoch in a slot.
+ *
+ * It counts only once the epoch is seen unchanged after the announcement,
+ * so a reclaimer that advanced it in between is not missed.
+ * @return The epoch announced.
+ */
+unsigned long long ConcurrentGraph::announceEpoch(std::atomic<unsigned long long>& announced) const {
+    unsigned long long entered = epoch.load();
+    for (;;) {
+        announced.store(entered);
+        unsigned long long now = epoch.load();
+        if (now == entered) return entered;
+        entered = now;
+    }
+}
+
+/**
+ * @brief Get a node for an edge from a writer slot's cache.
+ *
+ * An empty cache takes a batch of reclaimed nodes from the graph's free
+ * list first, and only then carves a new chunk.
+ * @return The node, live as of born.
+ */
+ConcurrentGraph::Node* ConcurrentGraph::allocate(WriterSlot& writer, int dest, int weight,
+                                                 unsigned long long born) {
+    if (writer.free == nullptr) writer.free = takeFreeBatch(writer);
+    Node* node = writer.free;
+    if (node != nullptr) {
+        writer.free = node->retired_next;
+    } else {
+        if (writer.fresh_left == 0) {
+            Chunk* chunk = new Chunk;
+            chunk->next = chunks.load(std::memory_order_relaxed);
+            while (!chunks.compare_exchange_weak(chunk->next, chunk, std::memory_order_release,
+                                                 std::memory_order_relaxed)) {}
+            writer.fresh = chunk->nodes;
+            writer.fresh_left = CHUNK_NODES;
+        }
+        node = writer.fresh++;
+        writer.fresh_left--;
+    }
+    node->dest = dest;
+    node->weight = weight;
+    node->born = born;
+    node->died.store(LIVE, std::memory_order_relaxed);
+    return node;
+}
+
+/**
+ * @brief Pop a batch of reclaimed nodes off the graph's free list.
+ *
+ * The writer announces an epoch while it holds the old top, so that node
+ * cannot be handed out, retired and pushed back meanwhile: the
+ * compare-and-swap never succeeds on a recycled top (no ABA).
+ * @return First node of the batch, linked by retired_next, or nullptr.
+ */
+ConcurrentGraph::Node* ConcurrentGraph::takeFreeBatch(WriterSlot& writer) {
+    if (free_batches.load(std::memory_order_relaxed) == nullptr) return nullptr;
+    announceEpoch(writer.epoch);
+    Node* top = free_batches.load(std::memory_order_acquire);
+    while (top != nullptr &&
+           !free_batches.compare_exchange_weak(top, top->next.load(std::memory_order_relaxed),
+                                               std::memory_order_acquire, std::memory_order_acquire)) {}
+    writer.epoch.store(INACTIVE);
+    return top;
+}
+
+/**
+ * @brief Publish a node as the new head of src's list, without locking.
+ *
+ * A failed compare-and-swap only means another node went in first; the
+ * node is relinked behind it and tried again.
+ */
+void ConcurrentGraph::push(int src, Node* node) {
+    Row& row = rows[src];
+    Node* head = row.head.load(std::memory_order_relaxed);
+    do {
+        node->next.store(head, std::memory_order_relaxed);
+    } while (!row.head.compare_exchange_weak(head, node, std::memory_order_release,
+                                             std::memory_order_relaxed));
+    row.degree.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Find the live copy of the edge src -> dest with the highest stamp,
+ *        among finished updates. Requires src's stripe.
+ *
+ * Both halves of a finished undirected edge are linked, so findMirror
+ * finds the other one.
+ * @return The node, or nullptr.
+ */
+ConcurrentGraph::Node* ConcurrentGraph::findLive(int src, int dest, const unsigned long long* seen) const {
+    Node* best = nullptr;
+    for (Node* node = rows[src].head.load(std::memory_order_acquire); node != nullptr;
+         node = node->next.load(std::memory_order_acquire)) {
+        if (node->dest == dest && finished(node->born, seen) &&
+            node->died.load(std::memory_order_relaxed) == LIVE && (best == nullptr || node->born > best->born)) {
+            best = node;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Find the live half src -> dest added by the same update as another
+ *        node. Requires src's stripe.
+ *
+ * Matching by stamp rather than by list position picks the right copy
+ * even when parallel copies were pushed in opposite orders on the two
+ * lists. skip excludes the first half of a self-loop.
+ * @return The node, or nullptr.
+ */
+ConcurrentGraph::Node* ConcurrentGraph::findMirror(int src, int dest, unsigned long long born,
+                                                   const Node* skip) const {
+    for (Node* node = rows[src].head.load(std::memory_order_acquire); node != nullptr;
+         node = node->next.load(std::memory_order_acquire)) {
+        if (node != skip && node->dest == dest && node->born == born &&
+            node->died.load(std::memory_order_relaxed) == LIVE) return node;
+    }
+    return nullptr;
+}
+
+/// Mark a node removed by the update with stamp died; it stays linked. Requires src's stripe.
+void ConcurrentGraph::kill(int src, Node* node, unsigned long long died) {
+    node->died.store(died, std::memory_order_release);
+    rows[src].degree.fetch_sub(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Unlink a node from src's list. Requires src's stripe.
+ *
+ * The node keeps its next pointer, so a reader standing on it still
+ * reaches the rest of the list. Inserts only ever swap the head, so a node
+ * that is not the head can be unlinked with a plain store; unlinking the
+ * head races with them and falls back to a search if one got in first.
+ */
+void ConcurrentGraph::unlinkNode(int src, Node* node) {
+    Node* next = node->next.load(std::memory_order_relaxed);
+    Node* head = node;
+    if (rows[src].head.compare_exchange_strong(head, next, std::memory_order_acq_rel,
+                                               std::memory_order_acquire)) return;
+    Node* prev = head;
+    while (prev->next.load(std::memory_order_acquire) != node) {
+        prev = prev->next.load(std::memory_order_acquire);
+    }
+    prev->next.store(next, std::memory_order_release);
+}
+
+/// Queue removed nodes for unlinking; runs the reclaimer if enough have piled up.
+void ConcurrentGraph::bury(const DeadEntry* entries, int count) {
+    bool full;
+    {
+        std::lock_guard<std::mutex> guard(dead_lock);
+        if (dead_size + count > dead_capacity) {
+            int capacity = dead_capacity == 0 ? 64 : dead_capacity;
+            while (capacity < dead_size + count) capacity *= 2;
+            DeadEntry* grown = new DeadEntry[capacity];
+            for (int i = 0; i < dead_size; ++i) grown[i] = dead[i];
+            delete[] dead;
+            dead = grown;
+            dead_capacity = capacity;
+        }
+        for (int i = 0; i < count; ++i) dead[dead_size++] = entries[i];
+        full = dead_size >= COLLECT_THRESHOLD;
+    }
+    if (full && reclaim_lock.try_lock()) {   ///< Another thread reclaiming is good enough.
+        collect();
+        reclaim_lock.unlock();
+    }
+}
+
+/**
+ * @brief Find, per writer slot, the fewest finished updates an open view sees.
+ * @param oldest Filled with WRITER_SLOTS counts.
+ * @return False if a view is still being opened, so nothing may be unlinked.
+ */
+bool ConcurrentGraph::oldestSeen(unsigned long long* oldest) const {
+    snapshot(oldest);
+    for (int i = 0; i < reader_count; ++i) {
+        int state = readers[i].state.load();
+        if (state == IDLE) continue;
+        if (state == ENTERING) return false;
+        for (int w = 0; w < WRITER_SLOTS; ++w) {
+            unsigned long long seen = readers[i].seen[w].load();
+            if (seen < oldest[w]) oldest[w] = seen;
+        }
+    }
+    return true;
+}
+
+/// @return Oldest epoch an open view, or a writer taking a free batch, entered in.
+unsigned long long ConcurrentGraph::oldestEpoch() const {
+    unsigned long long oldest = epoch.load();
+    for (int i = 0; i < reader_count; ++i) {
+        unsigned long long entered = readers[i].epoch.load();
+        if (entered < oldest) oldest = entered;
+    }
+    for (int w = 0; w < WRITER_SLOTS; ++w) {
+        unsigned long long entered = writers[w].epoch.load();
+        if (entered < oldest) oldest = entered;
+    }
+    return oldest;
+}
+
+/**
+ * @brief Unlink removed nodes no view can see and recycle unlinked nodes no
+ *        reader can reach. Requires reclaim_lock.
+ *
+ * A node removed by an update is unlinked once every open view sees that
+ * update. It is tagged with the current epoch, the epoch is advanced, and
+ * once every reader entered in a later epoch the node goes onto the
+ * graph's free list, in batches of up to FREE_BATCH nodes.
+ */
+void ConcurrentGraph::collect() {
+    DeadEntry* entries;
+    int count;
+    {
+        std::lock_guard<std::mutex> guard(dead_lock);
+        entries = dead;
+        count = dead_size;
+        dead = nullptr;
+        dead_size = 0;
+        dead_capacity = 0;
+    }
+
+    unsigned long long oldest[WRITER_SLOTS];
+    bool unlinking = oldestSeen(oldest);
+    unsigned long long tag = epoch.load();
+    int kept = 0;
+    for (int i = 0; i < count; ++i) {
+        Node* node = entries[i].node;
+        if (!unlinking || !finished(node->died.load(std::memory_order_acquire), oldest)) {
+            entries[kept++] = entries[i];
+            continue;
+        }
+        {
+            StripeGuard guard(*this, entries[i].vertex, entries[i].vertex);
+            unlinkNode(entries[i].vertex, node);
+        }
+        node->retired_epoch = tag;
+        node->retired_next = limbo;
+        limbo = node;
+    }
+    if (kept > 0) {
+        std::lock_guard<std::mutex> guard(dead_lock);
+        if (dead_size + kept > dead_capacity) {
+            DeadEntry* grown = new DeadEntry[dead_size + kept];
+            for (int i = 0; i < dead_size; ++i) grown[i] = dead[i];
+            delete[] dead;
+            dead = grown;
+            dead_capacity = dead_size + kept;
+        }
+        for (int i = 0; i < kept; ++i) dead[dead_size++] = entries[i];
+    }
+    delete[] entries;
+
+    epoch.fetch_add(1);
+    unsigned long long safe = oldestEpoch();
+    Node* batch = nullptr;
+    int batched = 0;
+    Node** link = &limbo;
+    while (*link != nullptr) {
+        Node* node = *link;
+        if (node->retired_epoch >= safe) {
+            link = &node->retired_next;
+            continue;
+        }
+        *link = node->retired_next;
+        node->retired_next = batch;
+        batch = node;
+        if (++batched == FREE_BATCH || *link == nullptr) {
+            batch->next.store(free_batches.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            Node* top = batch->next.load(std::memory_order_relaxed);
+            while (!free_batches.compare_exchange_weak(top, batch, std::memory_order_release,
+                                                       std::memory_order_relaxed)) {
+                batch->next.store(top, std::memory_order_relaxed);
+            }
+            batch = nullptr;
+            batched = 0;
+        }
+    }
+}
+
+/**
+ * @brief Add a weighted edge (an arc src -> dest if directed).
+ *
+ * Takes no locks and waits for no other update; both halves of an
+ * undirected edge get the same stamp, so views see them together. Safe to
+ * call from any thread.
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @param weight Weight of the edge.
+ */
+void ConcurrentGraph::addEdge(int src, int dest, int weight) {
+    if (!isValid(src, dest)) {
+        std::cout << "Invalid edge!" << std::endl;
+        return;
+    }
+    int slot = acquireWriter();
+    WriterSlot& writer = writers[slot];
+    unsigned long long born = stamp(slot, ++writer.sequence);
+    push(src, allocate(writer, dest, weight, born));
+    if (edge_direction == Direction::UNDIRECTED) {
+        push(dest, allocate(writer, src, weight, born));   ///< A self-loop is listed twice, as in Graph.
+    }
+    finish(writer);
+    releaseWriter(slot);
+}
+
+/**
+ * @brief Remove an edge between two vertices (the arc src -> dest if directed).
+ *
+ * Of parallel copies, removes the one getEdgeWeight reports. Views opened
+ * earlier keep seeing the edge. Safe to call from any thread.
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @throws std::runtime_error If the edge does not exist.
+ */
+void ConcurrentGraph::removeEdge(int src, int dest) {
+    if (!isValid(src, dest)) {
+        std::cout << "Invalid edge!" << std::endl;
+        return;
+    }
+    bool mirrored = edge_direction == Direction::UNDIRECTED;
+    DeadEntry removed[2] = {{src, nullptr}, {dest, nullptr}};
+    int slot = acquireWriter();
+    WriterSlot& writer = writers[slot];
+    {
+        StripeGuard guard(*this, src, mirrored ? dest : src);
+        unsigned long long seen[WRITER_SLOTS];
+        snapshot(seen);
+        removed[0].node = findLive(src, dest, seen);
+        if (removed[0].node != nullptr) {
+            unsigned long long died = stamp(slot, ++writer.sequence);
+            kill(src, removed[0].node, died);
+            if (mirrored) {
+                removed[1].node = findMirror(dest, src, removed[0].node->born, removed[0].node);
+                kill(dest, removed[1].node, died);
+            }
+        }
+    }
+    if (removed[0].node == nullptr) {
+        releaseWriter(slot);
+        throw std::runtime_error("The edge does not exist and cannot be removed");
+    }
+    finish(writer);
+    releaseWriter(slot);
+    bury(removed, mirrored ? 2 : 1);
+}
+
+/**
+ * @brief Unlink and recycle the removed nodes that no open view needs.
+ *
+ * Safe to call from any thread at any time; nodes still needed by an open
+ * view are kept for a later call.
+ */
+void ConcurrentGraph::reclaim() {
+    std::lock_guard<std::mutex> guard(reclaim_lock);
+    collect();
+}
+
+/// @return Removed nodes not yet back on the free list.
+int ConcurrentGraph::pendingReclaim() {
+    std::lock_guard<std::mutex> collecting(reclaim_lock);
+    int pending = 0;
+    for (Node* node = limbo; node != nullptr; node = node->retired_next) pending++;
+    std::lock_guard<std::mutex> guard(dead_lock);
+    return pending + dead_size;
+}
+
+/// @return Nodes carved from chunks so far, whether in use or free.
+long long ConcurrentGraph::allocatedNodes() const {
+    long long total = 0;
+    for (Chunk* chunk = chunks.load(std::memory_order_acquire); chunk != nullptr; chunk = chunk->next) {
+        total += CHUNK_NODES;
+    }
+    return total;
+}
+
+/**
+ * @brief Print the entire graph as one ReadView sees it.
+ *
+ * Displays each vertex followed by its neighbors, newest first.
+ */
+void ConcurrentGraph::print_graph() const {
+    ReadView view(*this);
+    OutputBuffer out(std::cout);
+    dump(view, out);
+    out.flush();
+}
+
+/// @return Number of vertices in the graph.
+int ConcurrentGraph::getNumVertices() const {
+    return num_of_vertices;
+}
+
+/**
+ * @brief Get the current number of neighbors of a vertex.
+ * @param vertex Vertex index.
+ * @return Number of neighbors, or 0 if invalid vertex.
+ */
+int ConcurrentGraph::getNeighborCount(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return 0;
+    return rows[vertex].degree.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the current neighbors of a vertex, newest first.
+ *
+ * Each call opens its own view; open a ReadView to keep several calls
+ * consistent with each other.
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of neighbors, or nullptr if invalid.
+ * @note Caller is responsible for freeing the array.
+ */
+int* ConcurrentGraph::getNeighbors(int vertex) const {
+    ReadView view(*this);
+    return view.getNeighbors(vertex);
+}
+
+/**
+ * @brief Get the current weights of the edges of a vertex.
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of weights, or nullptr if invalid.
+ * @note Caller is responsible for freeing the array.
+ */
+int* ConcurrentGraph::getNeighborWeights(int vertex) const {
+    ReadView view(*this);
+    return view.getNeighborWeights(vertex);
+}
+
+/**
+ * @brief Get the current weight of an edge between two vertices.
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @return Weight of the copy removeEdge would remove, or -1 if invalid or edge not found.
+ */
+int ConcurrentGraph::getEdgeWeight(int src, int dest) const {
+    ReadView view(*this);
+    return view.getEdgeWeight(src, dest);
+}
+
+/**
+ * @brief Check if an edge currently exists between two vertices.
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @return True if the edge exists, false otherwise.
+ */
+bool ConcurrentGraph::containsEdge(int src, int dest) const {
+    ReadView view(*this);
+    return view.containsEdge(src, dest);
+}
+
+/**
+ * @brief Count the total number of edges in the graph from the list degrees.
+ *
+ * Updates still running may be counted in part.
+ * @return Number of edges (arcs if directed).
+ */
+long long ConcurrentGraph::countEdges() const {
+    long long stored = 0;
+    for (int v = 0; v < num_of_vertices; ++v) stored += rows[v].degree.load(std::memory_order_relaxed);
+    if (edge_direction == Direction::DIRECTED) return stored;
+    return stored / 2; ///< Divide by 2 since the graph is undirected.
+}
+
+} // namespace graph
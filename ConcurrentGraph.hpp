@@ -0,0 +1,258 @@
+// ronavraham99@gmail.com
+
+#ifndef CONCURRENT_GRAPH_HPP
+#define CONCURRENT_GRAPH_HPP
+
+#include "Graph.hpp"
+#include <atomic>
+#include <mutex>
+
+namespace graph {
+
+/**
+ * @class ConcurrentGraph
+ * @brief Graph that many threads can update and query at the same time.
+ *
+ * Each vertex keeps its edges in a singly linked list with an atomic head.
+ * addEdge takes no locks: it pushes its nodes onto the heads with a
+ * compare-and-swap. removeEdge locks only the stripes of the vertices it
+ * touches, always in ascending order, so removals on overlapping vertex
+ * pairs cannot deadlock.
+ *
+ * Every update runs in one of WRITER_SLOTS writer slots and gets a stamp:
+ * the slot plus the slot's own sequence number. A slot publishes how many
+ * of its updates have finished, and a ReadView copies those counters when
+ * it opens. Finishing an update also bumps one shared completion count,
+ * and the view repeats its copy until that count held still across it, so
+ * the copy is the set of updates finished at one instant. A node records
+ * the stamps that added and removed it, so the view sees each update whole
+ * or not at all, and the same ones however long it runs: Algorithms run
+ * on a ReadView get one graph state that really existed while writers
+ * carry on. Updates are not ordered by a shared ticket, so an insert never
+ * waits for another update while a slot is free, and readers take no locks.
+ *
+ * A removed node stays linked until every open view sees its removal; it
+ * is then unlinked, and once every reader that might still be standing on
+ * it has finished (epoch-based reclamation) it goes back on the graph's
+ * free list for new edges. reclaim() runs this, and removals run it
+ * themselves as removed nodes pile up.
+ */
+class ConcurrentGraph {
+public:
+    typedef int vertex_type;  ///< Vertex ID type.
+    typedef int weight_type;  ///< Weight type.
+
+    /// Default number of lock stripes.
+    static constexpr int DEFAULT_STRIPES = 256;
+    /// Default number of reader slots, i.e. ReadViews open at once.
+    static constexpr int DEFAULT_READERS = 64;
+    /// Updates that can run at once; more wait for a slot.
+    static constexpr int WRITER_SLOTS = 64;
+
+private:
+    /// One edge in a vertex's list.
+    struct Node {
+        int dest;
+        int weight;
+        unsigned long long born;                ///< Stamp of the update that added the edge.
+        std::atomic<unsigned long long> died;   ///< Stamp of the update that removed it, or LIVE.
+        std::atomic<Node*> next;   ///< Next edge; still valid after this node is unlinked.
+        Node* retired_next;        ///< Next node awaiting reclamation, or of the same free batch.
+        unsigned long long retired_epoch;       ///< Epoch in which it was unlinked.
+    };
+
+    /// Block of nodes handed out by the writer slots.
+    static constexpr int CHUNK_NODES = 256;
+    struct Chunk {
+        Node nodes[CHUNK_NODES];
+        Chunk* next;
+    };
+
+    /// Edge list of one vertex.
+    struct Row {
+        std::atomic<Node*> head;  ///< Newest edge.
+        std::atomic<int> degree;  ///< Live edges in the list.
+    };
+
+    /// Writer lock shared by the vertices v with v % stripe_count equal.
+    struct alignas(64) Stripe {
+        std::mutex lock;
+    };
+
+    /// One running update: its progress and its node cache.
+    struct alignas(64) WriterSlot {
+        std::atomic<bool> busy;
+        std::atomic<unsigned long long> done;   ///< Sequence number of the last finished update.
+        std::atomic<unsigned long long> epoch;  ///< Epoch while taking a free batch, else INACTIVE.
+        unsigned long long sequence;   ///< Last update started; the rest is guarded by busy.
+        Node* free;                    ///< Free nodes, linked by retired_next.
+        Node* fresh;                   ///< Next never-used node of the current chunk.
+        int fresh_left;
+    };
+
+    /// What one reader announces to the reclaimer.
+    struct alignas(64) ReaderSlot {
+        std::atomic<bool> busy;
+        std::atomic<int> state;                   ///< IDLE, ENTERING or READING.
+        std::atomic<unsigned long long> epoch;    ///< Epoch at entry.
+        std::atomic<unsigned long long> seen[WRITER_SLOTS];  ///< Finished updates per writer slot.
+    };
+
+    /// A removed node still linked into a vertex's list.
+    struct DeadEntry {
+        int vertex;
+        Node* node;
+    };
+
+    /// Holds the stripes of one or two vertices, locked in ascending order.
+    class StripeGuard {
+        Stripe* first;
+        Stripe* second;   ///< nullptr if both vertices share a stripe.
+    public:
+        StripeGuard(const ConcurrentGraph& g, int u, int v);
+        ~StripeGuard();
+        StripeGuard(const StripeGuard&) = delete;
+        StripeGuard& operator=(const StripeGuard&) = delete;
+    };
+
+    /// Stamp of the sequence-th update of a writer slot.
+    static unsigned long long stamp(int slot, unsigned long long sequence) {
+        return sequence * WRITER_SLOTS + slot;
+    }
+
+    /// Whether a stamp belongs to an update finished in a snapshot of the writer slots.
+    static bool finished(unsigned long long stamp, const unsigned long long* seen) {
+        return stamp / WRITER_SLOTS <= seen[stamp % WRITER_SLOTS];
+    }
+
+    int num_of_vertices;       ///< Number of vertices in the graph.
+    Direction edge_direction;  ///< Whether edges are mirrored.
+    Row* rows;
+    Stripe* stripes;
+    int stripe_count;          ///< A power of two.
+
+    WriterSlot* writers;
+    std::atomic<unsigned long long> completed;   ///< Updates finished, in any slot.
+    ReaderSlot* readers;
+    int reader_count;
+
+    std::atomic<Chunk*> chunks;      ///< Every chunk allocated, freed with the graph.
+    std::atomic<Node*> free_batches; ///< Batches of reclaimed nodes, linked by next.
+
+    std::mutex dead_lock;
+    DeadEntry* dead;           ///< Removed nodes still linked, guarded by dead_lock.
+    int dead_size;
+    int dead_capacity;
+
+    std::mutex reclaim_lock;
+    std::atomic<unsigned long long> epoch;    ///< Reclamation epoch.
+    Node* limbo;               ///< Unlinked nodes, guarded by reclaim_lock.
+
+    bool isValid(int src, int dest) const;
+    int acquireWriter();
+    void releaseWriter(int slot);
+    void finish(WriterSlot& writer);
+    void snapshot(unsigned long long* seen) const;
+    bool oldestSeen(unsigned long long* oldest) const;
+    unsigned long long announceEpoch(std::atomic<unsigned long long>& announced) const;
+    Node* allocate(WriterSlot& writer, int dest, int weight, unsigned long long born);
+    Node* takeFreeBatch(WriterSlot& writer);
+    void push(int src, Node* node);
+    Node* findLive(int src, int dest, const unsigned long long* seen) const;
+    Node* findMirror(int src, int dest, unsigned long long born, const Node* skip) const;
+    void kill(int src, Node* node, unsigned long long died);
+    void unlinkNode(int src, Node* node);
+    void bury(const DeadEntry* entries, int count);
+    void collect();
+    unsigned long long oldestEpoch() const;
+
+public:
+    /**
+     * @class ReadView
+     * @brief Consistent read-only view of a ConcurrentGraph.
+     *
+     * Sees every update that had finished when it was opened and none that
+     * had not, for as long as it is open. Offers Graph's query API, so
+     * Algorithms run on it directly. Each thread opens its own views; a
+     * view holds a reader slot, and opening one waits while all slots are
+     * taken.
+     */
+    class ReadView {
+    public:
+        typedef int vertex_type;  ///< Vertex ID type.
+        typedef int weight_type;  ///< Weight type.
+
+    private:
+        const ConcurrentGraph& graph;
+        ReaderSlot* slot;
+        unsigned long long seen[WRITER_SLOTS];  ///< Finished updates per writer slot.
+
+        bool visible(const Node* node) const {
+            return finished(node->born, seen) && !finished(node->died.load(std::memory_order_acquire), seen);
+        }
+
+    public:
+        explicit ReadView(const ConcurrentGraph& g);
+        ~ReadView();
+        ReadView(const ReadView&) = delete;
+        ReadView& operator=(const ReadView&) = delete;
+
+        /**
+         * @brief Visit the edges of a vertex in this view, newest first.
+         * @param visit Called as visit(dest, weight) per edge.
+         */
+        template <typename Visitor>
+        void forEachNeighbor(int vertex, Visitor visit) const {
+            if (vertex < 0 || vertex >= graph.num_of_vertices) return;
+            for (const Node* node = graph.rows[vertex].head.load(std::memory_order_acquire); node != nullptr;
+                 node = node->next.load(std::memory_order_acquire)) {
+                if (visible(node)) visit(node->dest, node->weight);
+            }
+        }
+
+        int getNumVertices() const;
+        int getNeighborCount(int vertex) const;
+        int* getNeighbors(int vertex) const;
+        int* getNeighborWeights(int vertex) const;
+        int getEdgeWeight(int src, int dest) const;
+        bool containsEdge(int src, int dest) const;
+        long long countEdges() const;
+        Direction direction() const {return graph.edge_direction;}
+    };
+
+    ConcurrentGraph(int vertices, Direction direction = Direction::UNDIRECTED,
+                    int stripes = DEFAULT_STRIPES, int readers = DEFAULT_READERS);
+    ~ConcurrentGraph();
+    ConcurrentGraph(const ConcurrentGraph&) = delete;
+    ConcurrentGraph& operator=(const ConcurrentGraph&) = delete;
+
+    void addEdge(int src, int dest, int weight = 1);
+    void removeEdge(int src, int dest);
+    void reclaim();
+    int pendingReclaim();
+    long long allocatedNodes() const;
+
+    /**
+     * @brief Visit the current edges of a vertex, newest first, without locking.
+     * @param visit Called as visit(dest, weight) per edge.
+     */
+    template <typename Visitor>
+    void forEachNeighbor(int vertex, Visitor visit) const {
+        ReadView view(*this);
+        view.forEachNeighbor(vertex, visit);
+    }
+
+    void print_graph() const;
+    int getNumVertices() const;
+    int getNeighborCount(int vertex) const;
+    int* getNeighbors(int vertex) const;
+    int* getNeighborWeights(int vertex) const;
+    int getEdgeWeight(int src, int dest) const;
+    bool containsEdge(int src, int dest) const;
+    long long countEdges() const;
+    Direction direction() const {return edge_direction;}
+};
+
+} // namespace graph
+
+#endif // CONCURRENT_GRAPH_HPP
@@ -3,25 +3,29 @@
 #ifndef DATA_STRUCTURES_HPP
 #define DATA_STRUCTURES_HPP
 
+#include "GraphTypes.hpp"
+
 namespace graph {
 
 /**
  * @struct Queue
  * @brief A simple circular queue implementation for integers.
+ * @tparam T Integer type of the elements (vertex IDs).
  */
+template <typename T = int>
 struct Queue {
-    int* data;        ///< Array to hold elements.
-    int capacity;     ///< Maximum number of elements.
-    int front;        ///< Index of the front element.
-    int rear;         ///< Index of the next insertion.
-    int size;         ///< Current number of elements.
+    T* data;          ///< Array to hold elements.
+    T capacity;       ///< Maximum number of elements.
+    T front;          ///< Index of the front element.
+    T rear;           ///< Index of the next insertion.
+    T size;           ///< Current number of elements.
 
     /**
      * @brief Construct a new Queue with given capacity.
      * @param cap Maximum number of elements.
      */
-    Queue(int cap) : capacity(cap), front(0), rear(0), size(0) {
-        data = new int[capacity];
+    Queue(T cap) : capacity(cap), front(0), rear(0), size(0) {
+        data = new T[capacity];
     }
 
     /// Destructor – releases allocated memory.
@@ -34,7 +38,7 @@ struct Queue {
      * @param val Value to insert.
      * @note Does nothing if the queue is full.
      */
-    void enqueue(int val) {
+    void enqueue(T val) {
         if (size == capacity) return;
         data[rear] = val;
         rear = (rear + 1) % capacity;
@@ -43,11 +47,11 @@ struct Queue {
 
     /**
      * @brief Remove and return the front element.
-     * @return The front value, or -1 if the queue is empty.
+     * @return The front value, or T(-1) if the queue is empty.
      */
-    int dequeue() {
-        if (isEmpty()) return -1;
-        int val = data[front];
+    T dequeue() {
+        if (isEmpty()) return none<T>();
+        T val = data[front];
         front = (front + 1) % capacity;
         --size;
         return val;
@@ -65,22 +69,25 @@ struct Queue {
 /**
  * @struct PriorityQueue
  * @brief A simple array-based priority queue (min-priority).
+ * @tparam T Integer type of the values (vertex IDs).
+ * @tparam P Type of the priorities.
  */
+template <typename T = int, typename P = int>
 struct PriorityQueue {
-    int* values;       ///< Stored values.
-    int* priorities;   ///< Corresponding priorities.
-    int size;          ///< Current number of elements.
-    int capacity;      ///< Maximum capacity.
+    T* values;         ///< Stored values.
+    P* priorities;     ///< Corresponding priorities.
+    T size;            ///< Current number of elements.
+    T capacity;        ///< Maximum capacity.
 
     /**
      * @brief Construct a new PriorityQueue with given capacity.
      * @param cap Maximum number of elements.
      */
-    PriorityQueue(int cap) : size(0), capacity(cap) {
-        values = new int[capacity];
-        priorities = new int[capacity];
-        for (int i = 0; i < capacity; ++i)
-            priorities[i] = 1e9; ///< Initialize with "infinity".
+    PriorityQueue(T cap) : size(0), capacity(cap) {
+        values = new T[capacity];
+        priorities = new P[capacity];
+        for (T i = 0; i < capacity; ++i)
+            priorities[i] = infinity<P>(); ///< Initialize with "infinity".
     }
 
     /// Destructor – releases allocated memory.
@@ -95,7 +102,7 @@ struct PriorityQueue {
      * @param priority The associated priority.
      * @note Does nothing if the queue is full.
      */
-    void insert(int value, int priority) {
+    void insert(T value, P priority) {
         if (size == capacity) return;
         values[size] = value;
         priorities[size] = priority;
@@ -104,16 +111,16 @@ struct PriorityQueue {
 
     /**
      * @brief Extract the value with the smallest priority.
-     * @return The value with minimum priority, or -1 if empty.
+     * @return The value with minimum priority, or T(-1) if empty.
      */
-    int extractMin() {
-        if (size == 0) return -1;
-        int minIndex = 0;
-        for (int i = 1; i < size; ++i) {
+    T extractMin() {
+        if (size == 0) return none<T>();
+        T minIndex = 0;
+        for (T i = 1; i < size; ++i) {
             if (priorities[i] < priorities[minIndex])
                 minIndex = i;
         }
-        int val = values[minIndex];
+        T val = values[minIndex];
         values[minIndex] = values[size - 1];
         priorities[minIndex] = priorities[size - 1];
         --size;
@@ -125,8 +132,8 @@ struct PriorityQueue {
      * @param value The value to update.
      * @param newPriority The new priority.
      */
-    void decreaseKey(int value, int newPriority) {
-        for (int i = 0; i < size; ++i) {
+    void decreaseKey(T value, P newPriority) {
+        for (T i = 0; i < size; ++i) {
             if (values[i] == value && priorities[i] > newPriority) {
                 priorities[i] = newPriority;
                 break;
@@ -146,20 +153,22 @@ struct PriorityQueue {
 /**
  * @struct unionFind
  * @brief Disjoint-set (Union-Find) data structure with path compression and union by rank.
+ * @tparam T Integer type of the elements (vertex IDs).
  */
+template <typename T = int>
 struct unionFind {
-    int* parent;   ///< Parent array for disjoint sets.
+    T* parent;     ///< Parent array for disjoint sets.
     int* rank;     ///< Rank array for balancing unions.
-    int size;      ///< Number of elements.
+    T size;        ///< Number of elements.
 
     /**
      * @brief Construct a new unionFind with n elements.
      * @param n Number of elements.
      */
-    unionFind(int n) : size(n) {
-        parent = new int[n];
+    unionFind(T n) : size(n) {
+        parent = new T[n];
         rank = new int[n];
-        for (int i = 0; i < n; ++i) {
+        for (T i = 0; i < n; ++i) {
             parent[i] = i;
             rank[i] = 0;
         }
@@ -177,7 +186,7 @@ struct unionFind {
      * @return Root of the set.
      * @note Uses path compression for efficiency.
      */
-    int find(int x) {
+    T find(T x) {
         if (parent[x] != x)
             parent[x] = find(parent[x]);
         return parent[x];
@@ -189,9 +198,9 @@ struct unionFind {
      * @param y Second element.
      * @note Uses union by rank heuristic.
      */
-    void unite(int x, int y) {
-        int rx = find(x);
-        int ry = find(y);
+    void unite(T x, T y) {
+        T rx = find(x);
+        T ry = find(y);
         if (rx == ry) return;
         if (rank[rx] < rank[ry])
             parent[rx] = ry;
@@ -204,6 +213,147 @@ struct unionFind {
     }
 };
 
+/**
+ * @struct HashIndex
+ * @brief Open-addressing hash table mapping integer keys to values.
+ * @tparam K Integer key type (vertex IDs).
+ * @tparam T Value type.
+ *
+ * Uses linear probing with backward-shift deletion, so no tombstones
+ * accumulate and lookups stay O(1) expected under any insert/erase mix.
+ * The table doubles when its load factor exceeds 1/2.
+ */
+template <typename K, typename T>
+struct HashIndex {
+    K* keys;                 ///< Stored keys.
+    T* values;               ///< Values associated with keys.
+    unsigned char* used;     ///< 1 if the slot is occupied, 0 otherwise.
+    int capacity;            ///< Number of slots (always a power of two).
+    int shift;               ///< 64 - log2(capacity), used by the hash function.
+    int size;                ///< Number of stored keys.
+
+    /**
+     * @brief Construct an index able to hold at least `expected` keys without growing.
+     * @param expected Expected number of keys.
+     */
+    HashIndex(int expected = 8) : size(0) {
+        capacity = 16;
+        while (capacity < expected * 2) capacity *= 2;
+        allocate(capacity);
+    }
+
+    /// Destructor – releases allocated memory.
+    ~HashIndex() {
+        release();
+    }
+
+    /**
+     * @brief Find the value stored for a key.
+     * @param key Key to search.
+     * @return Pointer to the value, or nullptr if the key is absent.
+     */
+    T* find(K key) const {
+        int mask = capacity - 1;
+        for (int i = slotOf(key); used[i]; i = (i + 1) & mask) {
+            if (keys[i] == key) return &values[i];
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Insert a key or overwrite its value if already present.
+     * @param key Key to insert.
+     * @param value Value to associate with the key.
+     * @return Pointer to the stored value.
+     */
+    T* insert(K key, const T& value) {
+        if ((size + 1) * 2 > capacity) grow();
+        int mask = capacity - 1;
+        int i = slotOf(key);
+        while (used[i]) {
+            if (keys[i] == key) {
+                values[i] = value;
+                return &values[i];
+            }
+            i = (i + 1) & mask;
+        }
+        used[i] = 1;
+        keys[i] = key;
+        values[i] = value;
+        ++size;
+        return &values[i];
+    }
+
+    /**
+     * @brief Remove a key from the index.
+     * @param key Key to remove.
+     * @return True if the key was present, false otherwise.
+     * @note Shifts later entries of the probe run back into the freed slot.
+     */
+    bool erase(K key) {
+        int mask = capacity - 1;
+        int i = slotOf(key);
+        while (used[i] && keys[i] != key) i = (i + 1) & mask;
+        if (!used[i]) return false;
+
+        int hole = i;
+        for (int j = (i + 1) & mask; used[j]; j = (j + 1) & mask) {
+            int home = slotOf(keys[j]);
+            // Move j into the hole unless its home slot lies cyclically in (hole, j].
+            bool stays = (hole <= j) ? (hole < home && home <= j) : (hole < home || home <= j);
+            if (!stays) {
+                keys[hole] = keys[j];
+                values[hole] = values[j];
+                hole = j;
+            }
+        }
+        used[hole] = 0;
+        --size;
+        return true;
+    }
+
+private:
+    /// Fibonacci hashing of a key into a slot index.
+    int slotOf(K key) const {
+        unsigned long long h = static_cast<unsigned long long>(key) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<int>(h >> shift);
+    }
+
+    void allocate(int cap) {
+        capacity = cap;
+        shift = 64;
+        for (int c = cap; c > 1; c >>= 1) --shift;
+        keys = new K[cap];
+        values = new T[cap];
+        used = new unsigned char[cap];
+        for (int i = 0; i < cap; ++i) used[i] = 0;
+    }
+
+    void release() {
+        delete[] keys;
+        delete[] values;
+        delete[] used;
+    }
+
+    /// Double the capacity and reinsert all keys.
+    void grow() {
+        K* oldKeys = keys;
+        T* oldValues = values;
+        unsigned char* oldUsed = used;
+        int oldCapacity = capacity;
+
+        allocate(capacity * 2);
+        size = 0;
+        for (int i = 0; i < oldCapacity; ++i) {
+            if (oldUsed[i]) insert(oldKeys[i], oldValues[i]);
+        }
+
+        delete[] oldKeys;
+        delete[] oldValues;
+        delete[] oldUsed;
+    }
+};
+
 } // namespace graph
 
 #endif // DATA_STRUCTURES_HPP
@@ -0,0 +1,478 @@
+// ronavraham99@gmail.com
+
+#include "DeltaGraph.hpp"
+#include "DataStructures.hpp"
+#include "Dump.hpp"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace graph {
+
+/// Destination and weight of one arc, sortable by destination.
+struct DeltaArc {
+    int dest;
+    int weight;
+};
+
+/// Destructor – releases the row arrays.
+DeltaGraph::Snapshot::~Snapshot() {
+    delete[] offsets;
+    delete[] dests;
+    delete[] weights;
+}
+
+/// Construct an empty log for a number of vertices.
+DeltaGraph::Log::Log(int vertices) : records(nullptr), size(0), capacity(0) {
+    heads = new int[vertices];
+    for (int v = 0; v < vertices; ++v) heads[v] = -1;
+}
+
+/// Destructor – releases the records and chain heads.
+DeltaGraph::Log::~Log() {
+    delete[] records;
+    delete[] heads;
+}
+
+/// Append a record and make it the newest of its source's chain.
+void DeltaGraph::Log::append(int src, int dest, int weight, bool tombstone) {
+    if (size == capacity) {
+        capacity = capacity == 0 ? 64 : capacity * 2;
+        Record* grown = new Record[capacity];
+        for (int i = 0; i < size; ++i) grown[i] = records[i];
+        delete[] records;
+        records = grown;
+    }
+    records[size] = {src, dest, weight, heads[src], tombstone};
+    heads[src] = size++;
+}
+
+/**
+ * @brief Set up an empty graph with an empty log and no snapshot.
+ * @param vertices Number of vertices in the graph.
+ * @param direction Whether edges are stored in both directions.
+ */
+void DeltaGraph::init(int vertices, Direction direction) {
+    num_of_vertices = vertices;
+    edge_direction = direction;
+    degrees = new int[vertices];
+    for (int v = 0; v < vertices; ++v) degrees[v] = 0;
+    arcs = 0;
+    base = nullptr;
+    active = new Log(vertices);
+    sealed = nullptr;
+    next = nullptr;
+    sealed_arcs = 0;
+    compacted = false;
+}
+
+/**
+ * @brief Construct an empty delta graph.
+ * @param vertices Number of vertices in the graph.
+ * @param direction Whether edges are stored in both directions.
+ * @param options Compaction thresholds.
+ */
+DeltaGraph::DeltaGraph(int vertices, Direction direction, const DeltaOptions& options)
+    : options(options) {
+    init(vertices, direction);
+    base = new Snapshot;
+    base->offsets = new long long[vertices + 1];
+    for (int v = 0; v <= vertices; ++v) base->offsets[v] = 0;
+    base->dests = new int[0];
+    base->weights = new int[0];
+}
+
+/**
+ * @brief Freeze a graph into the initial snapshot.
+ *
+ * Parallel edges keep Graph's newest-first order within a row.
+ * @param g Graph to copy; later changes to it are not seen.
+ * @param options Compaction thresholds.
+ */
+DeltaGraph::DeltaGraph(const Graph& g, const DeltaOptions& options) : options(options) {
+    init(g.getNumVertices(), g.direction());
+    base = new Snapshot;
+    base->offsets = new long long[num_of_vertices + 1];
+    base->offsets[0] = 0;
+    for (int v = 0; v < num_of_vertices; ++v) {
+        degrees[v] = g.getNeighborCount(v);
+        base->offsets[v + 1] = base->offsets[v] + degrees[v];
+    }
+    arcs = base->offsets[num_of_vertices];
+    base->dests = new int[arcs];
+    base->weights = new int[arcs];
+
+    for (int v = 0; v < num_of_vertices; ++v) {
+        int* neighbors = g.getNeighbors(v);
+        int* weights = g.getNeighborWeights(v);
+        DeltaArc* row = new DeltaArc[degrees[v]];
+        for (int i = 0; i < degrees[v]; ++i) row[i] = {neighbors[i], weights[i]};
+        std::stable_sort(row, row + degrees[v], [](const DeltaArc& a, const DeltaArc& b) {
+            return a.dest < b.dest;
+        });
+        for (int i = 0; i < degrees[v]; ++i) {
+            base->dests[base->offsets[v] + i] = row[i].dest;
+            base->weights[base->offsets[v] + i] = row[i].weight;
+        }
+        delete[] row;
+        delete[] neighbors;
+        delete[] weights;
+    }
+}
+
+/// Destructor – waits for a running compaction, then frees everything.
+DeltaGraph::~DeltaGraph() {
+    if (compactor.joinable()) compactor.join();
+    delete base;
+    delete next;
+    delete active;
+    delete sealed;
+    delete[] degrees;
+}
+
+/// @return True if both endpoints are valid vertices.
+bool DeltaGraph::isValid(int src, int dest) const {
+    return src >= 0 && dest >= 0 && src < num_of_vertices && dest < num_of_vertices;
+}
+
+/**
+ * @brief Merge a snapshot row with a vertex's log records.
+ *
+ * Walks the records newest-first, so each tombstone is pending until it
+ * meets the next older insert of its destination (or, failing that, a
+ * snapshot copy), which it cancels. The surviving inserts are sorted and
+ * merged with the snapshot row. Parallel copies stay newest-first, which
+ * is the order liveCopies() and the next compaction rely on.
+ * @param newer Newest log, or nullptr.
+ * @param older Older log, or nullptr.
+ * @param dests Receives the live destinations in ascending order.
+ * @param weights Receives their weights.
+ * @return Number of live arcs written.
+ */
+int DeltaGraph::mergeRow(const Snapshot* snapshot, const Log* newer, const Log* older,
+                         int vertex, int* dests, int* weights) const {
+    const Log* logs[2] = {newer, older};
+    int chained = 0;
+    for (const Log* log : logs) {
+        if (log == nullptr) continue;
+        for (int i = log->heads[vertex]; i >= 0; i = log->records[i].next) chained++;
+    }
+    if (chained == 0) {     ///< Nothing logged: the snapshot row as it is.
+        long long first = snapshot->offsets[vertex];
+        int count = static_cast<int>(snapshot->offsets[vertex + 1] - first);
+        std::copy(snapshot->dests + first, snapshot->dests + first + count, dests);
+        std::copy(snapshot->weights + first, snapshot->weights + first + count, weights);
+        return count;
+    }
+
+    DeltaArc* inserts = new DeltaArc[chained];
+    int kept = 0;
+    HashIndex<int, int> pending;      ///< Uncancelled tombstones per destination.
+    for (const Log* log : logs) {
+        if (log == nullptr) continue;
+        for (int i = log->heads[vertex]; i >= 0; i = log->records[i].next) {
+            const Record& record = log->records[i];
+            int* waiting = pending.find(record.dest);
+            if (record.tombstone) {
+                if (waiting != nullptr) {
+                    (*waiting)++;
+                } else {
+                    pending.insert(record.dest, 1);
+                }
+            } else if (waiting != nullptr && *waiting > 0) {
+                (*waiting)--;
+            } else {
+                inserts[kept++] = {record.dest, record.weight};
+            }
+        }
+    }
+    std::stable_sort(inserts, inserts + kept, [](const DeltaArc& a, const DeltaArc& b) {
+        return a.dest < b.dest;
+    });
+
+    int count = 0;
+    int i = 0;
+    for (long long at = snapshot->offsets[vertex]; at < snapshot->offsets[vertex + 1]; ++at) {
+        int dest = snapshot->dests[at];
+        int* waiting = pending.size > 0 ? pending.find(dest) : nullptr;
+        if (waiting != nullptr && *waiting > 0) {
+            (*waiting)--;
+            continue;
+        }
+        for (; i < kept && inserts[i].dest <= dest; ++i) {    ///< Logged copies are newer.
+            dests[count] = inserts[i].dest;
+            weights[count++] = inserts[i].weight;
+        }
+        dests[count] = dest;
+        weights[count++] = snapshot->weights[at];
+    }
+    for (; i < kept; ++i) {
+        dests[count] = inserts[i].dest;
+        weights[count++] = inserts[i].weight;
+    }
+    delete[] inserts;
+    return count;
+}
+
+/// @return True if either log holds a record of the vertex.
+bool DeltaGraph::logged(int vertex) const {
+    return active->heads[vertex] >= 0 || (sealed != nullptr && sealed->heads[vertex] >= 0);
+}
+
+/**
+ * @brief Copy a vertex's row of one snapshot array, for a vertex with no log records.
+ * @param column base->dests or base->weights.
+ * @return Dynamically allocated copy of the row.
+ */
+int* DeltaGraph::copyRow(const int* column, int vertex) const {
+    long long first = base->offsets[vertex];
+    int* row = new int[degrees[vertex]];
+    std::copy(column + first, column + first + degrees[vertex], row);
+    return row;
+}
+
+/**
+ * @brief Count the live copies of an arc.
+ * @param weight Receives the weight of the newest live copy, if any.
+ * @return Number of live copies of src -> dest.
+ */
+int DeltaGraph::liveCopies(int src, int dest, int& weight) const {
+    int copies = 0;
+    int pending = 0;
+    for (const Log* log : {active, sealed}) {
+        if (log == nullptr) continue;
+        for (int i = log->heads[src]; i >= 0; i = log->records[i].next) {
+            const Record& record = log->records[i];
+            if (record.dest != dest) continue;
+            if (record.tombstone) {
+                pending++;
+            } else if (pending > 0) {
+                pending--;
+            } else if (copies++ == 0) {
+                weight = record.weight;
+            }
+        }
+    }
+
+    const int* row = base->dests + base->offsets[src];
+    const int* end = base->dests + base->offsets[src + 1];
+    const int* first = std::lower_bound(row, end, dest);
+    int stored = static_cast<int>(std::upper_bound(first, end, dest) - first);
+    if (stored > pending) {
+        if (copies == 0) weight = base->weights[first - base->dests + pending];
+        copies += stored - pending;
+    }
+    return copies;
+}
+
+/// Compactor: merge the snapshot with the sealed log into next.
+void DeltaGraph::buildNext() {
+    Snapshot* built = new Snapshot;
+    built->offsets = new long long[num_of_vertices + 1];
+    built->dests = new int[sealed_arcs];
+    built->weights = new int[sealed_arcs];
+    built->offsets[0] = 0;
+    for (int v = 0; v < num_of_vertices; ++v) {
+        long long at = built->offsets[v];
+        built->offsets[v + 1] = at + mergeRow(base, sealed, nullptr, v, built->dests + at, built->weights + at);
+    }
+    next = built;
+    compacted.store(true, std::memory_order_release);
+}
+
+/// Swap in a finished snapshot and free the one and the log it replaces.
+void DeltaGraph::install() {
+    if (sealed == nullptr || !compacted.load(std::memory_order_acquire)) return;
+    if (compactor.joinable()) compactor.join();
+    delete base;
+    delete sealed;
+    base = next;
+    next = nullptr;
+    sealed = nullptr;
+    compacted = false;
+}
+
+/**
+ * @brief Seal the active log and start folding it into a new snapshot.
+ * @param inBackground Run the merge on the compactor thread; otherwise
+ *        merge and install before returning.
+ */
+void DeltaGraph::seal(bool inBackground) {
+    sealed = active;
+    active = new Log(num_of_vertices);
+    sealed_arcs = arcs;
+    if (inBackground) {
+        compactor = std::thread(&DeltaGraph::buildNext, this);
+    } else {
+        buildNext();
+        install();
+    }
+}
+
+/// Install a finished compaction, and start one if the log is over its threshold.
+void DeltaGraph::maybeCompact() {
+    install();
+    if (sealed != nullptr) return;
+    double threshold = options.delta_ratio * base->offsets[num_of_vertices];
+    if (active->size >= options.min_delta && active->size >= threshold) {
+        seal(options.background);
+    }
+}
+
+/**
+ * @brief Add a weighted edge (an arc src -> dest if directed).
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @param weight Weight of the edge.
+ */
+void DeltaGraph::addEdge(int src, int dest, int weight) {
+    if (!isValid(src, dest)) {
+        std::cout << "Invalid edge!" << std::endl;
+        return;
+    }
+    active->append(src, dest, weight, false);
+    degrees[src]++;
+    arcs++;
+    if (edge_direction == Direction::UNDIRECTED) {
+        active->append(dest, src, weight, false);
+        degrees[dest]++;
+        arcs++;
+    }
+    maybeCompact();
+}
+
+/**
+ * @brief Remove an edge between two vertices (the arc src -> dest if directed).
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @throws std::runtime_error If the edge does not exist.
+ */
+void DeltaGraph::removeEdge(int src, int dest) {
+    if (!isValid(src, dest)) {
+        std::cout << "Invalid edge!" << std::endl;
+        return;
+    }
+    if (!containsEdge(src, dest)) {
+        throw std::runtime_error("The edge does not exist and cannot be removed");
+    }
+    active->append(src, dest, 0, true);
+    degrees[src]--;
+    arcs--;
+    if (edge_direction == Direction::UNDIRECTED) {
+        active->append(dest, src, 0, true);
+        degrees[dest]--;
+        arcs--;
+    }
+    maybeCompact();
+}
+
+/**
+ * @brief Fold every logged update into the snapshot now.
+ *
+ * Waits for a running compaction, then merges what was logged since.
+ */
+void DeltaGraph::compact() {
+    if (sealed != nullptr) {
+        if (compactor.joinable()) compactor.join();
+        install();
+    }
+    if (active->size > 0) seal(false);
+}
+
+/// @return Log records not yet folded into the snapshot.
+int DeltaGraph::deltaSize() const {
+    return active->size + (sealed != nullptr ? sealed->size : 0);
+}
+
+/**
+ * @brief Print the entire graph.
+ *
+ * Displays each vertex followed by its neighbors in ascending order.
+ */
+void DeltaGraph::print_graph() const {
+    OutputBuffer out(std::cout);
+    dump(*this, out);
+    out.flush();
+}
+
+/// @return Number of vertices in the graph.
+int DeltaGraph::getNumVertices() const {
+    return num_of_vertices;
+}
+
+/**
+ * @brief Get the number of neighbors for a given vertex.
+ * @param vertex Vertex index.
+ * @return Number of neighbors, or 0 if invalid vertex.
+ */
+int DeltaGraph::getNeighborCount(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return 0;
+    return degrees[vertex];
+}
+
+/**
+ * @brief Get all neighbors of a vertex in ascending order.
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of neighbors, or nullptr if invalid.
+ * @note Caller is responsible for freeing the array.
+ */
+int* DeltaGraph::getNeighbors(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return nullptr;
+    if (!logged(vertex)) return copyRow(base->dests, vertex);
+    int* neighbors = new int[degrees[vertex]];
+    int* weights = new int[degrees[vertex]];
+    mergeRow(base, active, sealed, vertex, neighbors, weights);
+    delete[] weights;
+    return neighbors;
+}
+
+/**
+ * @brief Get the weights of the edges of a vertex.
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of weights, parallel to getNeighbors(), or nullptr if invalid.
+ * @note Caller is responsible for freeing the array.
+ */
+int* DeltaGraph::getNeighborWeights(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return nullptr;
+    if (!logged(vertex)) return copyRow(base->weights, vertex);
+    int* neighbors = new int[degrees[vertex]];
+    int* weights = new int[degrees[vertex]];
+    mergeRow(base, active, sealed, vertex, neighbors, weights);
+    delete[] neighbors;
+    return weights;
+}
+
+/**
+ * @brief Get the weight of an edge between two vertices.
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @return Weight of the newest copy of the edge, or -1 if invalid or edge not found.
+ */
+int DeltaGraph::getEdgeWeight(int src, int dest) const {
+    if (!isValid(src, dest)) return -1;
+    int weight = -1;
+    liveCopies(src, dest, weight);
+    return weight;
+}
+
+/**
+ * @brief Check if an edge exists between two vertices.
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @return True if the edge exists, false otherwise.
+ */
+bool DeltaGraph::containsEdge(int src, int dest) const {
+    int weight;
+    return isValid(src, dest) && liveCopies(src, dest, weight) > 0;
+}
+
+/**
+ * @brief Count the total number of edges in the graph.
+ * @return Number of edges (arcs if directed).
+ */
+long long DeltaGraph::countEdges() const {
+    if (edge_direction == Direction::DIRECTED) return arcs;
+    return arcs / 2; ///< Divide by 2 since the graph is undirected.
+}
+
+} // namespace graph
@@ -0,0 +1,127 @@
+// ronavraham99@gmail.com
+
+#ifndef DELTA_GRAPH_HPP
+#define DELTA_GRAPH_HPP
+
+#include "Graph.hpp"
+#include <atomic>
+#include <thread>
+
+namespace graph {
+
+/// When a DeltaGraph folds its update log into a new snapshot.
+struct DeltaOptions {
+    int min_delta = 4096;         ///< Log records that always trigger a compaction.
+    double delta_ratio = 0.125;   ///< Or this fraction of the snapshot's arcs, if larger.
+    bool background = true;       ///< Compact on a background thread rather than inline.
+};
+
+/**
+ * @class DeltaGraph
+ * @brief Frozen CSR snapshot plus a log of later edge insertions and removals.
+ *
+ * The snapshot stores every row sorted by destination in two flat arrays
+ * and is never modified. addEdge appends an insert record to the log and
+ * removeEdge a tombstone; each record is chained to the previous record of
+ * the same source vertex, so a neighbor query merges the vertex's snapshot
+ * row with only its own records. A tombstone cancels the newest live copy
+ * of its edge, as removeEdge does on Graph.
+ *
+ * Once the log outgrows its threshold it is sealed and a background thread
+ * merges it with the snapshot into a new snapshot, while updates go to a
+ * fresh log and queries read the old snapshot and both logs. The next
+ * update (or compact()) installs the finished snapshot and frees the old
+ * one and the sealed log. Like Graph, a DeltaGraph is used from one thread;
+ * only the compaction runs concurrently.
+ *
+ * getNeighbors() returns neighbors in ascending order. Offers the same
+ * query API as Graph, so Algorithms run on it directly.
+ */
+class DeltaGraph {
+public:
+    typedef int vertex_type;  ///< Vertex ID type.
+    typedef int weight_type;  ///< Weight type.
+
+private:
+    /// Immutable CSR snapshot with rows sorted by destination.
+    struct Snapshot {
+        long long* offsets;   ///< Start of each row (num_of_vertices + 1 entries).
+        int* dests;           ///< Destinations, row after row.
+        int* weights;         ///< Weights, parallel to dests.
+        ~Snapshot();
+    };
+
+    /// One logged update.
+    struct Record {
+        int src;
+        int dest;
+        int weight;
+        int next;             ///< Previous record of the same source, or -1.
+        bool tombstone;       ///< Removal rather than insertion.
+    };
+
+    /// Append-only update log with a record chain per source vertex.
+    struct Log {
+        Record* records;
+        int size;
+        int capacity;
+        int* heads;           ///< Newest record of each vertex, or -1.
+        Log(int vertices);
+        ~Log();
+        void append(int src, int dest, int weight, bool tombstone);
+    };
+
+    int num_of_vertices;      ///< Number of vertices in the graph.
+    Direction edge_direction; ///< Whether edges are mirrored.
+    DeltaOptions options;
+    int* degrees;             ///< Live arcs per vertex.
+    long long arcs;           ///< Live arcs (twice the edges if undirected).
+
+    Snapshot* base;           ///< Current snapshot.
+    Log* active;              ///< Updates since the sealed log.
+    Log* sealed;              ///< Log being compacted, or nullptr.
+    Snapshot* next;           ///< Snapshot built by the compactor.
+    long long sealed_arcs;    ///< Live arcs of base plus sealed.
+    std::thread compactor;
+    std::atomic<bool> compacted;  ///< next is ready to install.
+
+    void init(int vertices, Direction direction);
+    bool isValid(int src, int dest) const;
+    int mergeRow(const Snapshot* snapshot, const Log* newer, const Log* older,
+                 int vertex, int* dests, int* weights) const;
+    bool logged(int vertex) const;
+    int* copyRow(const int* column, int vertex) const;
+    int liveCopies(int src, int dest, int& weight) const;
+    void buildNext();
+    void install();
+    void seal(bool inBackground);
+    void maybeCompact();
+
+public:
+    DeltaGraph(int vertices, Direction direction = Direction::UNDIRECTED,
+               const DeltaOptions& options = DeltaOptions());
+    DeltaGraph(const Graph& g, const DeltaOptions& options = DeltaOptions());
+    ~DeltaGraph();
+    DeltaGraph(const DeltaGraph&) = delete;
+    DeltaGraph& operator=(const DeltaGraph&) = delete;
+
+    void addEdge(int src, int dest, int weight = 1);
+    void removeEdge(int src, int dest);
+    void compact();
+    int deltaSize() const;
+    bool isCompacting() const {return sealed != nullptr;}
+
+    void print_graph() const;
+    int getNumVertices() const;
+    int getNeighborCount(int vertex) const;
+    int* getNeighbors(int vertex) const;
+    int* getNeighborWeights(int vertex) const;
+    int getEdgeWeight(int src, int dest) const;
+    bool containsEdge(int src, int dest) const;
+    long long countEdges() const;
+    Direction direction() const {return edge_direction;}
+};
+
+} // namespace graph
+
+#endif // DELTA_GRAPH_HPP
@@ -0,0 +1,250 @@
+// ronavraham99@gmail.com
+
+#include "DenseGraph.hpp"
+#include "Dump.hpp"
+#include <iostream>
+#include <stdexcept>
+
+namespace graph {
+
+/**
+ * @brief Allocate an empty bit matrix and weight matrix.
+ * @param vertices Number of vertices in the graph.
+ */
+void DenseGraph::init(int vertices) {
+    num_of_vertices = vertices;
+    words_per_row = (vertices + 63) / 64;
+
+    long long wordCount = static_cast<long long>(vertices) * words_per_row;
+    long long cellCount = static_cast<long long>(vertices) * vertices;
+    bits = new unsigned long long[wordCount];
+    weights = new int[cellCount];
+    degrees = new int[vertices];
+
+    for (long long i = 0; i < wordCount; ++i) bits[i] = 0;
+    for (int i = 0; i < vertices; ++i) degrees[i] = 0;
+}
+
+/**
+ * @brief Construct an empty dense graph.
+ * @param vertices Number of vertices in the graph.
+ * @param direction Whether edges are stored in both directions.
+ */
+DenseGraph::DenseGraph(int vertices, Direction direction) {
+    init(vertices);
+    edge_direction = direction;
+}
+
+/**
+ * @brief Build a dense copy of a graph.
+ *
+ * Parallel edges collapse into one; the last weight seen wins. The copy
+ * has the same direction as the source.
+ * @param g Graph to copy.
+ */
+DenseGraph::DenseGraph(const Graph& g) {
+    init(g.getNumVertices());
+    edge_direction = g.direction();
+    for (int u = 0; u < num_of_vertices; ++u) {
+        int count = g.getNeighborCount(u);
+        int* neighbors = g.getNeighbors(u);
+        int* w = g.getNeighborWeights(u);
+        for (int i = 0; i < count; ++i) {
+            setEdge(u, neighbors[i], w[i]);
+        }
+        delete[] neighbors;
+        delete[] w;
+    }
+}
+
+/// Destructor – releases both matrices.
+DenseGraph::~DenseGraph() {
+    delete[] bits;
+    delete[] weights;
+    delete[] degrees;
+}
+
+/// @return True if both endpoints are valid vertices.
+bool DenseGraph::isValid(int src, int dest) const {
+    return src >= 0 && dest >= 0 && src < num_of_vertices && dest < num_of_vertices;
+}
+
+/**
+ * @brief Set one direction of an edge.
+ * @param src Row vertex.
+ * @param dest Column vertex.
+ * @param weight Weight of the edge.
+ */
+void DenseGraph::setEdge(int src, int dest, int weight) {
+    unsigned long long& word = bits[static_cast<long long>(src) * words_per_row + dest / 64];
+    unsigned long long mask = 1ULL << (dest % 64);
+    if (!(word & mask)) {
+        word |= mask;
+        degrees[src]++;
+    }
+    weights[static_cast<long long>(src) * num_of_vertices + dest] = weight;
+}
+
+/**
+ * @brief Clear one direction of an edge.
+ * @param src Row vertex.
+ * @param dest Column vertex.
+ */
+void DenseGraph::clearEdge(int src, int dest) {
+    unsigned long long& word = bits[static_cast<long long>(src) * words_per_row + dest / 64];
+    unsigned long long mask = 1ULL << (dest % 64);
+    if (word & mask) {
+        word &= ~mask;
+        degrees[src]--;
+    }
+}
+
+/**
+ * @brief Add a weighted edge between two vertices (only src -> dest if directed).
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @param weight Weight of the edge.
+ * @note Does nothing if vertices are invalid; overwrites the weight of an existing edge.
+ */
+void DenseGraph::addEdge(int src, int dest, int weight) {
+    if (!isValid(src, dest)) {
+        std::cout << "Invalid edge!" << std::endl;
+        return;
+    }
+    setEdge(src, dest, weight);
+    if (edge_direction == Direction::DIRECTED) return;
+    setEdge(dest, src, weight); ///< Because the graph is undirected.
+}
+
+/**
+ * @brief Remove an edge between two vertices (only src -> dest if directed).
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @throws std::runtime_error If the edge does not exist.
+ */
+void DenseGraph::removeEdge(int src, int dest) {
+    if (!isValid(src, dest)) {
+        std::cout << "Invalid edge!" << std::endl;
+        return;
+    }
+    if (!containsEdge(src, dest)) {
+        throw std::runtime_error("The edge does not exist and cannot be removed");
+    }
+    clearEdge(src, dest);
+    if (edge_direction == Direction::DIRECTED) return;
+    clearEdge(dest, src); ///< Remove both directions.
+}
+
+/**
+ * @brief Print the entire graph.
+ *
+ * Displays each vertex followed by its neighbors in ascending order.
+ */
+void DenseGraph::print_graph() const {
+    OutputBuffer out(std::cout);
+    dump(*this, out);
+    out.flush();
+}
+
+/// @return Number of vertices in the graph.
+int DenseGraph::getNumVertices() const {
+    return num_of_vertices;
+}
+
+/**
+ * @brief Get the number of neighbors for a given vertex.
+ * @param vertex Vertex index.
+ * @return Number of neighbors, or 0 if invalid vertex.
+ */
+int DenseGraph::getNeighborCount(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return 0;
+    return degrees[vertex];
+}
+
+/**
+ * @brief Get all neighbors of a vertex by scanning its bit row.
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of neighbors in ascending order, or nullptr if invalid.
+ * @note Caller is responsible for freeing the array.
+ */
+int* DenseGraph::getNeighbors(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return nullptr;
+
+    int* neighbors = new int[degrees[vertex]];
+    const unsigned long long* row = bits + static_cast<long long>(vertex) * words_per_row;
+    int i = 0;
+    for (int w = 0; w < words_per_row; ++w) {
+        unsigned long long word = row[w];
+        while (word != 0) {
+            neighbors[i++] = w * 64 + __builtin_ctzll(word);
+            word &= word - 1;   ///< Clear the lowest set bit.
+        }
+    }
+    return neighbors;
+}
+
+/**
+ * @brief Get the weights of all edges leaving a vertex.
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of weights, parallel to getNeighbors(), or nullptr if invalid.
+ * @note Caller is responsible for freeing the array.
+ */
+int* DenseGraph::getNeighborWeights(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return nullptr;
+
+    int* result = new int[degrees[vertex]];
+    const unsigned long long* row = bits + static_cast<long long>(vertex) * words_per_row;
+    const int* weightRow = weights + static_cast<long long>(vertex) * num_of_vertices;
+    int i = 0;
+    for (int w = 0; w < words_per_row; ++w) {
+        unsigned long long word = row[w];
+        while (word != 0) {
+            result[i++] = weightRow[w * 64 + __builtin_ctzll(word)];
+            word &= word - 1;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Get the weight of an edge between two vertices.
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @return Edge weight, or -1 if invalid or edge not found.
+ */
+int DenseGraph::getEdgeWeight(int src, int dest) const {
+    if (!containsEdge(src, dest)) return -1;
+    return weights[static_cast<long long>(src) * num_of_vertices + dest];
+}
+
+/**
+ * @brief Check if an edge exists between two vertices in O(1).
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @return True if the edge exists, false otherwise.
+ */
+bool DenseGraph::containsEdge(int src, int dest) const {
+    if (!isValid(src, dest)) return false;
+    unsigned long long word = bits[static_cast<long long>(src) * words_per_row + dest / 64];
+    return (word >> (dest % 64)) & 1;
+}
+
+/**
+ * @brief Count the total number of edges in the graph.
+ *
+ * An undirected self-loop sets a single bit, so it is counted once on its
+ * own rather than halved with the mirrored edges; the total matches Graph.
+ * @return Number of undirected edges, or of arcs if the graph is directed.
+ */
+long long DenseGraph::countEdges() const {
+    long long total = 0;
+    for (int v = 0; v < num_of_vertices; ++v) {
+        total += degrees[v];
+    }
+    if (edge_direction == Direction::DIRECTED) return total;
+    long long loops = 0;
+    for (int v = 0; v < num_of_vertices; ++v) loops += containsEdge(v, v);
+    return (total - loops) / 2 + loops; ///< Mirrored edges count twice, self-loops once.
+}
+
+} // namespace graph
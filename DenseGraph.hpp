@@ -0,0 +1,65 @@
+// ronavraham99@gmail.com
+
+#ifndef DENSE_GRAPH_HPP
+#define DENSE_GRAPH_HPP
+
+#include "Graph.hpp"
+
+namespace graph {
+
+/**
+ * @class DenseGraph
+ * @brief Weighted graph stored as a bit matrix plus a weight matrix.
+ *
+ * Meant for small dense graphs (a few thousand vertices, density above
+ * roughly 25%), where one bit per vertex pair beats per-edge list storage.
+ * containsEdge is O(1), and neighbors are enumerated one 64-bit word at a
+ * time with popcount/count-trailing-zeros. Each vertex pair holds at most
+ * one edge; adding an existing edge overwrites its weight. Like Graph it
+ * is undirected unless constructed as Direction::DIRECTED. A self-loop is
+ * a single neighbor of its vertex, where Graph lists it twice, but counts
+ * as one edge in both.
+ *
+ * Offers the same query API as Graph, so Algorithms run on it directly.
+ */
+class DenseGraph {
+public:
+    typedef int vertex_type;  ///< Vertex ID type.
+    typedef int weight_type;  ///< Weight type.
+
+private:
+    int num_of_vertices;             ///< Number of vertices in the graph.
+    int words_per_row;               ///< 64-bit words in one adjacency row.
+    unsigned long long* bits;        ///< Adjacency bit matrix, row-major.
+    int* weights;                    ///< Edge weights, row-major n x n.
+    int* degrees;                    ///< Number of neighbors of each vertex.
+    Direction edge_direction;        ///< Whether edges are mirrored.
+
+    void init(int vertices);
+    bool isValid(int src, int dest) const;
+    void setEdge(int src, int dest, int weight);
+    void clearEdge(int src, int dest);
+
+public:
+    DenseGraph(int vertices, Direction direction = Direction::UNDIRECTED);
+    DenseGraph(const Graph& g);
+    ~DenseGraph();
+    DenseGraph(const DenseGraph&) = delete;
+    DenseGraph& operator=(const DenseGraph&) = delete;
+
+    void addEdge(int src, int dest, int weight = 1);
+    void removeEdge(int src, int dest);
+    void print_graph() const;
+    int getNumVertices() const;
+    int getNeighborCount(int vertex) const;
+    int* getNeighbors(int vertex) const;
+    int* getNeighborWeights(int vertex) const;
+    int getEdgeWeight(int src, int dest) const;
+    bool containsEdge(int src, int dest) const;
+    long long countEdges() const;
+    Direction direction() const {return edge_direction;}
+};
+
+} // namespace graph
+
+#endif // DENSE_GRAPH_HPP
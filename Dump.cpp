@@ -0,0 +1,115 @@
+// ronavraham99@gmail.com
+
+#include "Dump.hpp"
+#include "Graph.hpp"
+#include "CompressedGraph.hpp"
+#include "ConcurrentGraph.hpp"
+#include "DeltaGraph.hpp"
+#include "DenseGraph.hpp"
+#include "EdgeTableGraph.hpp"
+#include "PCSRGraph.hpp"
+#include "Snapshot.hpp"
+
+namespace graph {
+
+/**
+ * @brief Write the i-th weight of a getNeighborWeights() array.
+ *
+ * Unweighted graphs return no array; each of their edges weighs 1.
+ */
+template <typename W>
+static void putWeight(OutputBuffer& out, const W* weights, long long i) {
+    if constexpr (isWeighted<W>) {
+        out.putNumber(weights[i]);
+    } else {
+        out.put('1');
+    }
+}
+
+/**
+ * @brief Write one vertex's row in the given format.
+ *
+ * For EDGE_LIST and DOT, an undirected edge is written only from its smaller
+ * endpoint. Graph lists a self-loop twice and DenseGraph once, so a loop is
+ * written on every odd occurrence.
+ */
+template <typename V, typename W>
+static void dumpRow(OutputBuffer& out, DumpFormat format, bool directed,
+                    V v, V count, const V* neighbors, const W* weights) {
+    if (format == DumpFormat::ADJACENCY) {
+        out.put("vertex ");
+        out.putNumber(v);
+        out.put(": ");
+        for (V i = 0; i < count; ++i) {
+            out.put('(');
+            out.putNumber(neighbors[i]);
+            out.put(", weight ");
+            putWeight(out, weights, i);
+            out.put(") ");
+        }
+        out.put('\n');
+        return;
+    }
+
+    bool dot = format == DumpFormat::DOT;
+    if (dot && count == 0) {
+        out.put("  ");
+        out.putNumber(v);
+        out.put(";\n");
+    }
+    bool pendingLoop = false;
+    for (V i = 0; i < count; ++i) {
+        V u = neighbors[i];
+        if (u == v) pendingLoop = !pendingLoop;
+        if (!directed && !(v < u || (u == v && pendingLoop))) continue;
+        if (dot) out.put("  ");
+        out.putNumber(v);
+        out.put(!dot ? " " : directed ? " -> " : " -- ");
+        out.putNumber(u);
+        if (isWeighted<W>) {
+            out.put(dot ? " [weight=" : " ");
+            putWeight(out, weights, i);
+            if (dot) out.put(']');
+        }
+        out.put(dot ? ";\n" : "\n");
+    }
+}
+
+template <typename G>
+void dump(const G& g, OutputBuffer& out, DumpFormat format) {
+    typedef typename G::vertex_type V;
+    typedef typename G::weight_type W;
+    bool directed = g.direction() == Direction::DIRECTED;
+    if (format == DumpFormat::DOT) out.put(directed ? "digraph {\n" : "graph {\n");
+
+    for (V v = 0; v < g.getNumVertices(); ++v) {
+        V* neighbors = g.getNeighbors(v);
+        W* weights = g.getNeighborWeights(v);
+        try {     ///< A caller buffer can overflow mid-row.
+            dumpRow(out, format, directed, v, g.getNeighborCount(v), neighbors, weights);
+        } catch (...) {
+            delete[] neighbors;
+            delete[] weights;
+            throw;
+        }
+        delete[] neighbors;
+        delete[] weights;
+    }
+
+    if (format == DumpFormat::DOT) out.put("}\n");
+}
+
+#define GRAPH_INSTANTIATE_DUMP(...) \
+    template void dump<__VA_ARGS__>(const __VA_ARGS__&, OutputBuffer&, DumpFormat);
+#define GRAPH_INSTANTIATE_BASIC_DUMP(V, W) GRAPH_INSTANTIATE_DUMP(BasicGraph<V, W>)
+
+GRAPH_FOR_EACH_TYPE_PAIR(GRAPH_INSTANTIATE_BASIC_DUMP)
+GRAPH_INSTANTIATE_DUMP(CompressedGraph)
+GRAPH_INSTANTIATE_DUMP(ConcurrentGraph::ReadView)
+GRAPH_INSTANTIATE_DUMP(DeltaGraph)
+GRAPH_INSTANTIATE_DUMP(DenseGraph)
+GRAPH_INSTANTIATE_DUMP(EdgeTableGraph)
+GRAPH_INSTANTIATE_DUMP(PCSRGraph)
+GRAPH_INSTANTIATE_DUMP(SnapshotGraph)
+
+} // namespace graph
@@ -0,0 +1,33 @@
+// ronavraham99@gmail.com
+
+#ifndef DUMP_HPP
+#define DUMP_HPP
+
+#include "OutputBuffer.hpp"
+
+namespace graph {
+
+/// Text layouts written by dump().
+enum class DumpFormat {
+    ADJACENCY,   ///< print_graph's layout: "vertex v: (dest, weight w) ..." per line.
+    EDGE_LIST,   ///< "src dest weight" per edge (no weight if unweighted), readable by readEdgeList.
+    DOT          ///< Graphviz graph or digraph with weight attributes.
+};
+
+/**
+ * @brief Write a graph as text into an OutputBuffer.
+ *
+ * Works on any graph type with Graph's query API; instantiated in Dump.cpp
+ * for the same types as the algorithms. EDGE_LIST and DOT list each
+ * undirected edge once, from its smaller endpoint. The buffer is not
+ * flushed, so several dumps can share it.
+ * @param g Graph to write.
+ * @param out Destination buffer.
+ * @param format Text layout.
+ */
+template <typename G>
+void dump(const G& g, OutputBuffer& out, DumpFormat format = DumpFormat::ADJACENCY);
+
+} // namespace graph
+
+#endif // DUMP_HPP
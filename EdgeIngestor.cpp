@@ -0,0 +1,284 @@
+// ronavraham99@gmail.com
+
+#include "EdgeIngestor.hpp"
+#include "TextScanner.hpp"
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace graph {
+
+/// How long the reader waits for input before checking for stop().
+static const int POLL_MILLISECONDS = 100;
+
+/// Seconds elapsed since a point in time.
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Start ingesting from an open file descriptor, e.g. STDIN_FILENO.
+ * @param g Graph to add the edges to; only applyBatch() touches it.
+ * @param fd Stream to read; it is not closed by the ingestor.
+ * @param options Batch size, queue length and read buffer size.
+ * @throws std::invalid_argument If an option is not positive.
+ */
+EdgeIngestor::EdgeIngestor(Graph& g, int fd, const IngestOptions& options)
+    : target(g), options(options), fd(fd), owns_fd(false) {
+    init();
+}
+
+/**
+ * @brief Start ingesting from a file.
+ * @param g Graph to add the edges to; only applyBatch() touches it.
+ * @param path File (or named pipe) to read.
+ * @param options Batch size, queue length and read buffer size.
+ * @throws std::runtime_error If the file cannot be opened.
+ * @throws std::invalid_argument If an option is not positive.
+ */
+EdgeIngestor::EdgeIngestor(Graph& g, const char* path, const IngestOptions& options)
+    : target(g), options(options), fd(::open(path, O_RDONLY)), owns_fd(true) {
+    if (fd < 0) throw std::runtime_error("Cannot open edge stream");
+    try {
+        init();
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+}
+
+/// Allocate the batch ring and start the reader thread.
+void EdgeIngestor::init() {
+    if (options.batch_edges <= 0 || options.queue_batches <= 0 || options.read_bytes <= 0) {
+        throw std::invalid_argument("Ingest options must be positive");
+    }
+    batches = new Graph::Edge*[options.queue_batches];
+    batch_sizes = new int[options.queue_batches];
+    for (int i = 0; i < options.queue_batches; ++i) batches[i] = new Graph::Edge[options.batch_edges];
+    head = 0;
+    filled = 0;
+    ended = false;
+    failed = false;
+    stopping = false;
+    reader = std::thread(&EdgeIngestor::readStream, this);
+}
+
+/// Destructor – stops and joins the reader, then frees the batches.
+EdgeIngestor::~EdgeIngestor() {
+    stop();
+    reader.join();
+    if (owns_fd) ::close(fd);
+    for (int i = 0; i < options.queue_batches; ++i) delete[] batches[i];
+    delete[] batches;
+    delete[] batch_sizes;
+}
+
+/// Add the reader's progress since its last report to the shared counters. Requires lock.
+static void merge(IngestStats& counters, IngestStats& progress) {
+    counters.bytes_read += progress.bytes_read;
+    counters.edges_parsed += progress.edges_parsed;
+    counters.edges_rejected += progress.edges_rejected;
+    counters.lines_malformed += progress.lines_malformed;
+    counters.producer_wait_seconds += progress.producer_wait_seconds;
+    progress = IngestStats();
+}
+
+/**
+ * @brief Wait for a free batch.
+ * @param waited Receives the stall, if any.
+ * @return Index of the batch to fill, or -1 if stop() was called.
+ */
+int EdgeIngestor::acquire(double& waited) {
+    std::unique_lock<std::mutex> guard(lock);
+    if (filled == options.queue_batches && !stopping) {
+        counters.producer_stalls++;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        has_room.wait(guard, [this] { return filled < options.queue_batches || stopping; });
+        waited += secondsSince(start);
+    }
+    if (stopping) return -1;
+    return (head + filled) % options.queue_batches;
+}
+
+/// Hand a filled batch to applyBatch() and report the reader's progress.
+void EdgeIngestor::publish(int slot, int size, IngestStats& progress) {
+    std::lock_guard<std::mutex> guard(lock);
+    batch_sizes[slot] = size;
+    filled++;
+    if (filled > counters.max_queue_depth) counters.max_queue_depth = filled;
+    merge(counters, progress);
+    has_batch.notify_one();
+}
+
+/**
+ * @brief Reader thread: read, split into lines, parse and queue batches.
+ *
+ * A line cut by the end of a read is carried over to the next one. A line
+ * longer than the read buffer is counted as malformed and skipped.
+ */
+void EdgeIngestor::readStream() {
+    char* buffer = new char[options.read_bytes];
+    int kept = 0;                 ///< Bytes of an unfinished line at the start of buffer.
+    bool skipping = false;        ///< Discarding the rest of an over-long line.
+    int slot = -1;                ///< Batch being filled, if any.
+    int size = 0;
+    bool error = false;
+    IngestStats progress;
+
+    auto parse = [&](const char* begin, const char* end) {
+        Scanner in{begin, end};
+        while (in.at < in.end && slot != -2) {
+            long long src, dest, weight;
+            Scanner::LineKind kind = in.readEdgeLine(src, dest, weight);
+            if (kind == Scanner::MALFORMED || (kind == Scanner::EDGE && (weight < INT_MIN || weight > INT_MAX))) {
+                progress.lines_malformed++;
+            } else if (kind == Scanner::EDGE && (src < 0 || dest < 0 || src > INT_MAX || dest > INT_MAX)) {
+                progress.edges_rejected++;
+            } else if (kind == Scanner::EDGE) {
+                if (slot < 0) slot = acquire(progress.producer_wait_seconds);
+                if (slot < 0) {
+                    slot = -2;    ///< Stopped.
+                    break;
+                }
+                batches[slot][size++] = {static_cast<int>(src), static_cast<int>(dest), static_cast<int>(weight)};
+                progress.edges_parsed++;
+                if (size == options.batch_edges) {
+                    publish(slot, size, progress);
+                    slot = -1;
+                    size = 0;
+                }
+            }
+            in.nextLine();
+        }
+    };
+
+    while (!stopping && slot != -2) {
+        pollfd ready = {fd, POLLIN, 0};
+        int polled = ::poll(&ready, 1, POLL_MILLISECONDS);
+        if (polled == 0 || (polled < 0 && errno == EINTR)) continue;
+        ssize_t got = ::read(fd, buffer + kept, options.read_bytes - kept);
+        if (got < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+        if (got < 0) {
+            error = true;
+            break;
+        }
+        progress.bytes_read += got;
+        if (got == 0) {               ///< End of stream: the last line may lack a newline.
+            if (!skipping) parse(buffer, buffer + kept);
+            break;
+        }
+
+        int total = kept + static_cast<int>(got);
+        int complete = total;         ///< Bytes up to and including the last newline.
+        while (complete > 0 && buffer[complete - 1] != '\n') --complete;
+        if (complete == 0) {
+            if (total == options.read_bytes) {
+                if (!skipping) progress.lines_malformed++;
+                skipping = true;
+                total = 0;
+            }
+            kept = total;
+            continue;
+        }
+        int start = 0;
+        if (skipping) {
+            while (buffer[start] != '\n') ++start;
+            ++start;
+            skipping = false;
+        }
+        parse(buffer + start, buffer + complete);
+        kept = total - complete;
+        std::memmove(buffer, buffer + complete, kept);
+
+        if (slot >= 0 && size > 0) {  ///< Do not hold back edges of a slow stream.
+            publish(slot, size, progress);
+            slot = -1;
+            size = 0;
+        }
+    }
+
+    if (slot >= 0 && size > 0) publish(slot, size, progress);
+    delete[] buffer;
+    std::lock_guard<std::mutex> guard(lock);
+    merge(counters, progress);
+    ended = true;
+    failed = error;
+    has_batch.notify_all();
+}
+
+/**
+ * @brief Wait for the next batch and add its edges to the graph.
+ * @return False once the stream has ended and every batch has been applied.
+ * @throws std::runtime_error If the stream ended with a read error.
+ */
+bool EdgeIngestor::applyBatch() {
+    std::unique_lock<std::mutex> guard(lock);
+    if (filled == 0 && !ended) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        has_batch.wait(guard, [this] { return filled > 0 || ended; });
+        counters.consumer_wait_seconds += secondsSince(start);
+    }
+    if (filled == 0) {
+        if (failed) throw std::runtime_error("Failed to read edge stream");
+        return false;
+    }
+    int slot = head;
+    int size = batch_sizes[slot];
+    guard.unlock();
+
+    int vertices = target.getNumVertices();
+    Graph::Edge* batch = batches[slot];
+    int kept = 0;                     ///< Valid edges, compacted to the front of the batch.
+    for (int i = 0; i < size; ++i) {
+        if (batch[i].src < vertices && batch[i].dest < vertices) batch[kept++] = batch[i];
+    }
+    long long rejected = size - kept;
+    target.addEdges(batch, kept);
+
+    guard.lock();
+    head = (head + 1) % options.queue_batches;
+    filled--;
+    counters.edges_applied += size - rejected;
+    counters.edges_rejected += rejected;
+    counters.batches_applied++;
+    has_room.notify_one();
+    return true;
+}
+
+/**
+ * @brief Apply batches until the stream ends.
+ * @return Total number of edges added to the graph.
+ * @throws std::runtime_error If the stream ended with a read error.
+ */
+long long EdgeIngestor::applyAll() {
+    while (applyBatch()) {}
+    return stats().edges_applied;
+}
+
+/**
+ * @brief Stop reading.
+ *
+ * The reader exits within POLL_MILLISECONDS; batches already queued can
+ * still be applied.
+ */
+void EdgeIngestor::stop() {
+    std::lock_guard<std::mutex> guard(lock);
+    stopping = true;
+    has_room.notify_all();
+}
+
+/// @return A consistent snapshot of the counters; safe to call from any thread.
+IngestStats EdgeIngestor::stats() const {
+    std::lock_guard<std::mutex> guard(lock);
+    IngestStats snapshot = counters;
+    snapshot.queue_depth = filled;
+    snapshot.finished = ended && filled == 0;
+    return snapshot;
+}
+
+} // namespace graph
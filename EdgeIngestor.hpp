@@ -0,0 +1,95 @@
+// ronavraham99@gmail.com
+
+#ifndef EDGE_INGESTOR_HPP
+#define EDGE_INGESTOR_HPP
+
+#include "Graph.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace graph {
+
+/// Memory bounds of an EdgeIngestor.
+struct IngestOptions {
+    int batch_edges = 4096;       ///< Edges per batch.
+    int queue_batches = 8;        ///< Batches in flight; the reader waits when all are full.
+    int read_bytes = 1 << 16;     ///< Read buffer, also the longest accepted line.
+};
+
+/// Progress and backpressure counters of an EdgeIngestor.
+struct IngestStats {
+    long long bytes_read = 0;             ///< Bytes consumed from the stream.
+    long long edges_parsed = 0;           ///< Edges queued by the reader.
+    long long edges_applied = 0;          ///< Edges added to the graph.
+    long long edges_rejected = 0;         ///< Edges with an endpoint outside the graph.
+    long long lines_malformed = 0;        ///< Lines that are not a SNAP-style edge.
+    long long batches_applied = 0;        ///< Batches taken off the queue.
+    int queue_depth = 0;                  ///< Batches waiting to be applied.
+    int max_queue_depth = 0;              ///< Highest queue_depth seen.
+    long long producer_stalls = 0;        ///< Times the reader found the queue full.
+    double producer_wait_seconds = 0;     ///< Time the reader spent waiting on a full queue.
+    double consumer_wait_seconds = 0;     ///< Time applyBatch spent waiting for input.
+    bool finished = false;                ///< Stream ended and every batch was applied.
+};
+
+/**
+ * @class EdgeIngestor
+ * @brief Applies a SNAP-style edge stream to a Graph while it is still arriving.
+ *
+ * A reader thread parses the stream ("src dest [weight]" per line, as read
+ * by readEdgeList) into a ring of fixed-size edge batches. The caller takes
+ * batches off the ring with applyBatch() and adds them to the graph on its
+ * own thread, so it can query the graph between batches. Memory stays at
+ * queue_batches batches plus one read buffer whatever the stream length:
+ * when every batch is full the reader stops reading until one is applied,
+ * which pushes back on the writer of a pipe or socket. A partly filled
+ * batch is queued after every read, so edges from a slow feed are not held
+ * back waiting for a full batch.
+ *
+ * Edges with an endpoint outside the graph are counted in stats() and
+ * skipped, as are malformed lines.
+ */
+class EdgeIngestor {
+private:
+    Graph& target;                    ///< Graph the edges are added to.
+    IngestOptions options;
+    int fd;                           ///< Stream being read.
+    bool owns_fd;                     ///< Whether fd is closed on destruction.
+
+    Graph::Edge** batches;            ///< Ring of queue_batches batches.
+    int* batch_sizes;                 ///< Edges in each published batch.
+    int head;                         ///< Next batch to apply.
+    int filled;                       ///< Published batches not yet applied.
+    bool ended;                       ///< Reader is done; no more batches will come.
+    bool failed;                      ///< Reader stopped on a read error.
+    std::atomic<bool> stopping;       ///< stop() was called.
+    IngestStats counters;             ///< Guarded by lock.
+
+    mutable std::mutex lock;
+    std::condition_variable has_batch;
+    std::condition_variable has_room;
+    std::thread reader;
+
+    void init();
+    void readStream();
+    int acquire(double& waited);
+    void publish(int slot, int size, IngestStats& progress);
+
+public:
+    EdgeIngestor(Graph& g, int fd, const IngestOptions& options = IngestOptions());
+    EdgeIngestor(Graph& g, const char* path, const IngestOptions& options = IngestOptions());
+    ~EdgeIngestor();
+    EdgeIngestor(const EdgeIngestor&) = delete;
+    EdgeIngestor& operator=(const EdgeIngestor&) = delete;
+
+    bool applyBatch();
+    long long applyAll();
+    void stop();
+    IngestStats stats() const;
+};
+
+} // namespace graph
+
+#endif // EDGE_INGESTOR_HPP
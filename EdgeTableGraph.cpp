@@ -0,0 +1,315 @@
+// ronavraham99@gmail.com
+
+#include "EdgeTableGraph.hpp"
+#include "Dump.hpp"
+#include <iostream>
+#include <stdexcept>
+
+namespace graph {
+
+/**
+ * @brief Construct an empty edge-table graph.
+ * @param vertices Number of vertices in the graph.
+ */
+EdgeTableGraph::EdgeTableGraph(int vertices) {
+    num_of_vertices = vertices;
+    incident = new int*[vertices];
+    degrees = new int[vertices];
+    incident_capacity = new int[vertices];
+    for (int v = 0; v < vertices; ++v) {
+        incident[v] = nullptr;
+        degrees[v] = 0;
+        incident_capacity[v] = 0;
+    }
+
+    edge_capacity = 0;
+    edge_count = 0;
+    live_edges = 0;
+    free_head = -1;
+    ends = nullptr;
+    slots = nullptr;
+    weights = nullptr;
+}
+
+/// Destructor – releases the edge table and incidence lists.
+EdgeTableGraph::~EdgeTableGraph() {
+    for (int v = 0; v < num_of_vertices; ++v) delete[] incident[v];
+    delete[] incident;
+    delete[] degrees;
+    delete[] incident_capacity;
+    delete[] ends;
+    delete[] slots;
+    delete[] weights;
+}
+
+/// @return True if both endpoints are valid vertices.
+bool EdgeTableGraph::isValid(int src, int dest) const {
+    return src >= 0 && dest >= 0 && src < num_of_vertices && dest < num_of_vertices;
+}
+
+/// Double the edge table.
+void EdgeTableGraph::growEdges() {
+    int capacity = edge_capacity == 0 ? 16 : edge_capacity * 2;
+    int* newEnds = new int[2 * capacity];
+    int* newSlots = new int[2 * capacity];
+    int* newWeights = new int[capacity];
+    for (int i = 0; i < 2 * edge_count; ++i) {
+        newEnds[i] = ends[i];
+        newSlots[i] = slots[i];
+    }
+    for (int i = 0; i < edge_count; ++i) newWeights[i] = weights[i];
+
+    delete[] ends;
+    delete[] slots;
+    delete[] weights;
+    ends = newEnds;
+    slots = newSlots;
+    weights = newWeights;
+    edge_capacity = capacity;
+}
+
+/**
+ * @brief Append a half-edge to its endpoint's incidence list.
+ * @param half Half-edge (2 * id + side).
+ */
+void EdgeTableGraph::attach(int half) {
+    int v = ends[half];
+    if (degrees[v] == incident_capacity[v]) {
+        int capacity = incident_capacity[v] == 0 ? 4 : incident_capacity[v] * 2;
+        int* grown = new int[capacity];
+        for (int i = 0; i < degrees[v]; ++i) grown[i] = incident[v][i];
+        delete[] incident[v];
+        incident[v] = grown;
+        incident_capacity[v] = capacity;
+    }
+    slots[half] = degrees[v];
+    incident[v][degrees[v]++] = half;
+}
+
+/**
+ * @brief Remove a half-edge from its endpoint's incidence list in O(1).
+ *
+ * The last half-edge of the list moves into the hole.
+ * @param half Half-edge (2 * id + side).
+ */
+void EdgeTableGraph::detach(int half) {
+    int v = ends[half];
+    int slot = slots[half];
+    int moved = incident[v][--degrees[v]];
+    incident[v][slot] = moved;
+    slots[moved] = slot;
+}
+
+/**
+ * @brief Find the ID of an edge by scanning the shorter incidence list.
+ * @return Edge ID, or -1 if there is no such edge.
+ */
+int EdgeTableGraph::findEdge(int src, int dest) const {
+    if (degrees[dest] < degrees[src]) {
+        int swap = src;
+        src = dest;
+        dest = swap;
+    }
+    for (int i = 0; i < degrees[src]; ++i) {
+        int half = incident[src][i];
+        if (ends[half ^ 1] == dest) return half / 2;
+    }
+    return -1;
+}
+
+/**
+ * @brief Add an undirected weighted edge between two vertices.
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @param weight Weight of the edge.
+ * @return ID of the new edge, or -1 if vertices are invalid.
+ */
+int EdgeTableGraph::addEdge(int src, int dest, int weight) {
+    if (!isValid(src, dest)) {
+        std::cout << "Invalid edge!" << std::endl;
+        return -1;
+    }
+
+    int id;
+    if (free_head >= 0) {
+        id = free_head;
+        free_head = ends[2 * id + 1];
+    } else {
+        if (edge_count == edge_capacity) growEdges();
+        id = edge_count++;
+    }
+    ends[2 * id] = src;
+    ends[2 * id + 1] = dest;
+    weights[id] = weight;
+    attach(2 * id);
+    attach(2 * id + 1);     ///< A self-loop is listed twice, as in Graph.
+    live_edges++;
+    return id;
+}
+
+/**
+ * @brief Remove an edge by ID in O(1).
+ * @param id Edge ID returned by addEdge.
+ * @throws std::runtime_error If no edge has this ID.
+ */
+void EdgeTableGraph::removeEdgeById(int id) {
+    if (!hasEdgeId(id)) {
+        throw std::runtime_error("The edge does not exist and cannot be removed");
+    }
+    detach(2 * id);
+    detach(2 * id + 1);
+    ends[2 * id] = -1;
+    ends[2 * id + 1] = free_head;   ///< A free ID links to the next one.
+    free_head = id;
+    live_edges--;
+}
+
+/**
+ * @brief Remove an undirected edge between two vertices.
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @throws std::runtime_error If the edge does not exist.
+ */
+void EdgeTableGraph::removeEdge(int src, int dest) {
+    if (!isValid(src, dest)) {
+        std::cout << "Invalid edge!" << std::endl;
+        return;
+    }
+    int id = findEdge(src, dest);
+    if (id < 0) {
+        throw std::runtime_error("The edge does not exist and cannot be removed");
+    }
+    removeEdgeById(id);
+}
+
+/**
+ * @brief Update the weight of an edge by ID in O(1).
+ * @param id Edge ID returned by addEdge.
+ * @param weight New weight, seen from both endpoints.
+ * @throws std::runtime_error If no edge has this ID.
+ */
+void EdgeTableGraph::setEdgeWeight(int id, int weight) {
+    if (!hasEdgeId(id)) {
+        throw std::runtime_error("The edge does not exist");
+    }
+    weights[id] = weight;
+}
+
+/**
+ * @brief Get the weight of an edge by ID.
+ * @param id Edge ID.
+ * @return Edge weight, or -1 if no edge has this ID.
+ */
+int EdgeTableGraph::getWeightById(int id) const {
+    return hasEdgeId(id) ? weights[id] : -1;
+}
+
+/// @return True if id refers to an edge currently in the graph.
+bool EdgeTableGraph::hasEdgeId(int id) const {
+    return id >= 0 && id < edge_count && ends[2 * id] != -1;
+}
+
+/**
+ * @brief Get the ID of an edge between two vertices.
+ * @return Edge ID, or -1 if invalid or edge not found.
+ */
+int EdgeTableGraph::getEdgeId(int src, int dest) const {
+    if (!isValid(src, dest)) return -1;
+    return findEdge(src, dest);
+}
+
+/**
+ * @brief Get the IDs of all edges touching a vertex, parallel to getNeighbors().
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of edge IDs, or nullptr if invalid.
+ * @note Caller is responsible for freeing the array.
+ */
+int* EdgeTableGraph::getIncidentEdges(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return nullptr;
+    int* ids = new int[degrees[vertex]];
+    for (int i = 0; i < degrees[vertex]; ++i) ids[i] = incident[vertex][i] / 2;
+    return ids;
+}
+
+/**
+ * @brief Print the entire graph.
+ *
+ * Displays each vertex followed by its incident edges.
+ */
+void EdgeTableGraph::print_graph() const {
+    OutputBuffer out(std::cout);
+    dump(*this, out);
+    out.flush();
+}
+
+/// @return Number of vertices in the graph.
+int EdgeTableGraph::getNumVertices() const {
+    return num_of_vertices;
+}
+
+/**
+ * @brief Get the number of neighbors for a given vertex.
+ * @param vertex Vertex index.
+ * @return Number of neighbors, or 0 if invalid vertex.
+ */
+int EdgeTableGraph::getNeighborCount(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return 0;
+    return degrees[vertex];
+}
+
+/**
+ * @brief Get all neighbors of a vertex.
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of neighbors, or nullptr if invalid.
+ * @note Caller is responsible for freeing the array.
+ */
+int* EdgeTableGraph::getNeighbors(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return nullptr;
+    int* neighbors = new int[degrees[vertex]];
+    for (int i = 0; i < degrees[vertex]; ++i) neighbors[i] = ends[incident[vertex][i] ^ 1];
+    return neighbors;
+}
+
+/**
+ * @brief Get the weights of all edges touching a vertex.
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of weights, parallel to getNeighbors(), or nullptr if invalid.
+ * @note Caller is responsible for freeing the array.
+ */
+int* EdgeTableGraph::getNeighborWeights(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return nullptr;
+    int* result = new int[degrees[vertex]];
+    for (int i = 0; i < degrees[vertex]; ++i) result[i] = weights[incident[vertex][i] / 2];
+    return result;
+}
+
+/**
+ * @brief Get the weight of an edge between two vertices.
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @return Edge weight, or -1 if invalid or edge not found.
+ */
+int EdgeTableGraph::getEdgeWeight(int src, int dest) const {
+    int id = getEdgeId(src, dest);
+    return id < 0 ? -1 : weights[id];
+}
+
+/**
+ * @brief Check if an edge exists between two vertices.
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @return True if the edge exists, false otherwise.
+ */
+bool EdgeTableGraph::containsEdge(int src, int dest) const {
+    return getEdgeId(src, dest) >= 0;
+}
+
+/**
+ * @brief Count the total number of edges in the graph.
+ * @return Number of undirected edges.
+ */
+long long EdgeTableGraph::countEdges() const {
+    return live_edges;
+}
+
+} // namespace graph
@@ -0,0 +1,83 @@
+// ronavraham99@gmail.com
+
+#ifndef EDGE_TABLE_GRAPH_HPP
+#define EDGE_TABLE_GRAPH_HPP
+
+#include "Graph.hpp"
+
+namespace graph {
+
+/**
+ * @class EdgeTableGraph
+ * @brief Undirected weighted graph with one record per edge.
+ *
+ * Every edge lives once in an edge table (endpoints and weight) and is
+ * referenced by ID from the incidence lists of both endpoints, so weights
+ * are stored once instead of twice. Each incidence entry is a half-edge,
+ * 2 * id + side, where side 0 is seen from the first endpoint and side 1
+ * from the second; the other endpoint is ends[half ^ 1]. The table also
+ * records where each half-edge sits in its incidence list, so removing an
+ * edge or updating its weight by ID is O(1). Freed IDs are reused, linked
+ * through their own table entries.
+ *
+ * The O(1) updates by ID cost memory: about 28 bytes per edge (endpoints,
+ * slots, weight and two incidence entries), plus slack in the incidence
+ * lists, which is more than the two (destination, weight) pairs Graph
+ * stores. Use it when edges are updated by ID, not to save space.
+ *
+ * Offers the same query API as Graph, so Algorithms run on it directly.
+ */
+class EdgeTableGraph {
+public:
+    typedef int vertex_type;  ///< Vertex ID type.
+    typedef int weight_type;  ///< Weight type.
+
+private:
+    int num_of_vertices;      ///< Number of vertices in the graph.
+    int** incident;           ///< Half-edges of each vertex.
+    int* degrees;             ///< Number of half-edges of each vertex.
+    int* incident_capacity;   ///< Allocated length of each incidence list.
+
+    int* ends;                ///< Endpoints per half-edge; a free ID holds -1, then the next free ID.
+    int* slots;               ///< Position of each half-edge in its endpoint's incidence list.
+    int* weights;             ///< Weight per edge ID.
+    int free_head;            ///< Most recently released edge ID, or -1.
+    int edge_capacity;        ///< Allocated edge IDs.
+    int edge_count;           ///< IDs handed out so far (live or free).
+    int live_edges;           ///< Edges currently in the graph.
+
+    bool isValid(int src, int dest) const;
+    int findEdge(int src, int dest) const;
+    void growEdges();
+    void attach(int half);
+    void detach(int half);
+
+public:
+    EdgeTableGraph(int vertices);
+    ~EdgeTableGraph();
+    EdgeTableGraph(const EdgeTableGraph&) = delete;
+    EdgeTableGraph& operator=(const EdgeTableGraph&) = delete;
+
+    int addEdge(int src, int dest, int weight = 1);
+    void removeEdge(int src, int dest);
+    void removeEdgeById(int id);
+    void setEdgeWeight(int id, int weight);
+    int getWeightById(int id) const;
+    bool hasEdgeId(int id) const;
+    int getEdgeId(int src, int dest) const;
+    int* getIncidentEdges(int vertex) const;
+
+    void print_graph() const;
+    int getNumVertices() const;
+    int getNeighborCount(int vertex) const;
+    int* getNeighbors(int vertex) const;
+    int* getNeighborWeights(int vertex) const;
+    int getEdgeWeight(int src, int dest) const;
+    bool containsEdge(int src, int dest) const;
+    long long countEdges() const;
+    Direction direction() const {return Direction::UNDIRECTED;}
+};
+
+} // namespace graph
+
+#endif // EDGE_TABLE_GRAPH_HPP
@@ -1,52 +1,326 @@
 // ronavraham99@gmail.com
 
 #include "Graph.hpp"
+#include "Parallel.hpp"
+#include "WorkPool.hpp"
+#include <algorithm>
 #include <iostream>
 #include <stdexcept> 
 
 namespace graph {
 
+/// Vertices (or arena blocks) per chunk of the bulk constructor's per-vertex passes.
+static const long long VERTEX_GRAIN = 4096;
+
+/**
+ * @brief Construct a new undirected Graph with a given number of vertices.
+ * @param vertices Number of vertices in the graph.
+ * @param policy Degree thresholds at which adjacency lists change encoding.
+ */
+template <typename V, typename W>
+BasicGraph<V, W>::BasicGraph(V vertices, const StoragePolicy& policy)
+    : BasicGraph(vertices, Direction::UNDIRECTED, policy) {}
+
 /**
  * @brief Construct a new Graph with a given number of vertices.
  * 
  * Initializes an array of adjacency lists.
  * @param vertices Number of vertices in the graph.
+ * @param direction Whether edges are stored in both directions.
+ * @param policy Degree thresholds at which adjacency lists change encoding.
  */
-Graph::Graph(int vertices) {
+template <typename V, typename W>
+BasicGraph<V, W>::BasicGraph(V vertices, Direction direction, const StoragePolicy& policy) {
     num_of_vertices = vertices;
-    adjacency_vertices = new AdjacencyList[num_of_vertices]; ///< Create adjacency lists.
+    edge_direction = direction;
+    arena = nullptr;
+    in_offsets = nullptr;
+    in_sources = nullptr;
+    in_weights = nullptr;
+    storage = new StorageContext{policy, static_cast<long long>(vertices)};
+    adjacency_vertices = new List[num_of_vertices]; ///< Create adjacency lists.
+    for (V i = 0; i < num_of_vertices; ++i) {
+        adjacency_vertices[i].configure(storage);
+    }
+}
+
+/**
+ * @brief Build a graph from an edge list in two passes.
+ *
+ * See build() for how the work is split.
+ * @param vertices Number of vertices in the graph.
+ * @param edges Edge triples.
+ * @param count Number of triples.
+ * @param direction Whether edges are stored in both directions.
+ * @param policy Degree thresholds at which adjacency lists change encoding.
+ * @param threads Worker threads (0 for one per hardware thread). Each
+ *        needs a histogram of one vertex ID per vertex.
+ * @throws std::out_of_range If an edge refers to a vertex outside the graph.
+ */
+template <typename V, typename W>
+BasicGraph<V, W>::BasicGraph(V vertices, const Edge* edges, long long count,
+                             Direction direction, const StoragePolicy& policy,
+                             unsigned threads)
+    : BasicGraph(vertices, direction, policy) {
+    WorkPool pool(workerCount(threads, count));
+    build(edges, count, pool);
+}
+
+/**
+ * @brief Build a graph from an edge list on the workers of a pool.
+ * @param vertices Number of vertices in the graph.
+ * @param edges Edge triples.
+ * @param count Number of triples.
+ * @param direction Whether edges are stored in both directions.
+ * @param policy Degree thresholds at which adjacency lists change encoding.
+ * @param pool Workers to run on; each slice of the edge list needs a
+ *        histogram of one vertex ID per vertex.
+ * @throws std::out_of_range If an edge refers to a vertex outside the graph.
+ */
+template <typename V, typename W>
+BasicGraph<V, W>::BasicGraph(V vertices, const Edge* edges, long long count,
+                             Direction direction, const StoragePolicy& policy,
+                             WorkPool& pool)
+    : BasicGraph(vertices, direction, policy) {
+    build(edges, count, pool);
+}
+
+/**
+ * @brief Fill an empty graph from an edge list in two passes.
+ *
+ * The edge list is split into one contiguous slice per worker. Pass one
+ * validates each slice and counts per-vertex degrees into a slice-local
+ * histogram. The histograms are then turned into each slice's starting
+ * position within every vertex's list (an exclusive prefix sum across
+ * slices), and all adjacency blocks are allocated as one arena. Pass two
+ * writes each edge straight into its final slot with no synchronization,
+ * and a last pass links the blocks of each list. Since a slice's slots
+ * for a vertex follow those of all earlier slices, the result is the same
+ * graph as calling addEdge for each edge in order, whatever the thread
+ * count or which worker runs which slice.
+ *
+ * Slices hold equal numbers of edges. The per-vertex passes run in chunks
+ * of about equal block counts, so hub vertices do not stall one worker.
+ * @throws std::out_of_range If an edge refers to a vertex outside the graph.
+ */
+template <typename V, typename W>
+void BasicGraph<V, W>::build(const Edge* edges, long long count, WorkPool& pool) {
+    typedef typename List::Block Block;
+    bool mirrored = (edge_direction == Direction::UNDIRECTED);
+    unsigned slices = workerCount(pool.size(), count);
+    auto forEachEdgeSlice = [&](auto body) {
+        pool.forEachChunk(slices, 1, [&](long long first, long long last) {
+            for (long long t = first; t < last; ++t) {
+                body(static_cast<unsigned>(t), count * t / slices, count * (t + 1) / slices);
+            }
+        });
+    };
+
+    V** counts = new V*[slices];           ///< Per-slice degree histogram, then start positions.
+    bool* invalid = new bool[slices];
+    for (unsigned t = 0; t < slices; ++t) counts[t] = new V[num_of_vertices];
+
+    forEachEdgeSlice([&](unsigned t, long long begin, long long end) {
+        V* local = counts[t];
+        for (V v = 0; v < num_of_vertices; ++v) local[v] = 0;
+        invalid[t] = false;
+        for (long long i = begin; i < end; ++i) {
+            if (!inRange(edges[i].src, num_of_vertices) || !inRange(edges[i].dest, num_of_vertices)) {
+                invalid[t] = true;
+                return;
+            }
+            local[edges[i].src]++;
+            if (mirrored) local[edges[i].dest]++;
+        }
+    });
+
+    auto release = [&]() {
+        for (unsigned t = 0; t < slices; ++t) delete[] counts[t];
+        delete[] counts;
+        delete[] invalid;
+    };
+    for (unsigned t = 0; t < slices; ++t) {
+        if (invalid[t]) {
+            release();
+            throw std::out_of_range("Invalid edge in edge list");
+        }
+    }
+
+    V* degrees = new V[num_of_vertices];
+    pool.forEachChunk(num_of_vertices, VERTEX_GRAIN / slices, [&](long long begin, long long end) {
+        for (long long v = begin; v < end; ++v) {
+            V running = 0;
+            for (unsigned t = 0; t < slices; ++t) {
+                V c = counts[t][v];
+                counts[t][v] = running;
+                running += c;
+            }
+            degrees[v] = running;
+        }
+    });
+
+    long long* firstBlock = new long long[static_cast<long long>(num_of_vertices) + 1];   ///< Arena offset of each vertex's blocks.
+    long long blockCount = 0;
+    for (V v = 0; v < num_of_vertices; ++v) {
+        firstBlock[v] = blockCount;
+        blockCount += List::blocksFor(degrees[v]);
+    }
+    firstBlock[num_of_vertices] = blockCount;
+    arena = blockCount > 0 ? new Block[blockCount] : nullptr;
+    auto blocksOf = [&](V v) -> Block* {
+        return List::blocksFor(degrees[v]) > 0 ? arena + firstBlock[v] : nullptr;
+    };
+
+    forEachEdgeSlice([&](unsigned t, long long begin, long long end) {
+        V* next = counts[t];
+        for (long long i = begin; i < end; ++i) {
+            V u = edges[i].src;
+            V v = edges[i].dest;
+            adjacency_vertices[u].place(next[u]++, v, edges[i].weight, blocksOf(u));
+            if (mirrored) adjacency_vertices[v].place(next[v]++, u, edges[i].weight, blocksOf(v));
+        }
+    });
+
+    pool.forEachChunk(num_of_vertices, firstBlock, VERTEX_GRAIN, [&](long long begin, long long end) {
+        for (long long v = begin; v < end; ++v) {
+            adjacency_vertices[v].adopt(blocksOf(static_cast<V>(v)), degrees[v]);
+        }
+    });
+
+    release();
+    delete[] degrees;
+    delete[] firstBlock;
+}
+
+/**
+ * @brief Take over another graph's lists, arena and reverse index.
+ *
+ * Lets algorithms return the graphs they build by value. The source is
+ * left with no vertices and must not be queried from other threads
+ * while it is moved from.
+ */
+template <typename V, typename W>
+BasicGraph<V, W>::BasicGraph(BasicGraph&& other) noexcept
+    : num_of_vertices(other.num_of_vertices), adjacency_vertices(other.adjacency_vertices),
+      storage(other.storage), edge_direction(other.edge_direction), arena(other.arena),
+      in_offsets(other.in_offsets.load()), in_sources(other.in_sources),
+      in_weights(other.in_weights) {
+    other.num_of_vertices = 0;
+    other.adjacency_vertices = nullptr;
+    other.storage = nullptr;
+    other.arena = nullptr;
+    other.in_offsets = nullptr;
+    other.in_sources = nullptr;
+    other.in_weights = nullptr;
 }
 
 /// Destructor – releases adjacency list array.
-Graph::~Graph() {
+template <typename V, typename W>
+BasicGraph<V, W>::~BasicGraph() {
     delete[] adjacency_vertices; 
+    delete[] arena;             ///< After the lists, which may still point into it.
+    delete storage;
+    delete[] in_offsets.load();
+    delete[] in_sources;
+    delete[] in_weights;
+}
+
+/**
+ * @brief Return the reverse (in-edge) index of a directed graph, building it on first use.
+ *
+ * Counting sort of all arcs by target: one pass counts in-degrees, a
+ * second scatters each arc's source and weight into its target's range.
+ * Concurrent const queries may all arrive here; the first takes in_lock and
+ * builds, the others wait on the lock, and in_offsets is published last so
+ * a reader that sees it also sees the arrays it indexes.
+ */
+template <typename V, typename W>
+const long long* BasicGraph<V, W>::inIndex() const {
+    long long* built = in_offsets.load(std::memory_order_acquire);
+    if (built != nullptr) return built;
+    std::lock_guard<std::mutex> hold(in_lock);
+    built = in_offsets.load(std::memory_order_relaxed);
+    if (built != nullptr) return built;
+
+    long long* offsets = new long long[num_of_vertices + 1];
+    for (V v = 0; v <= num_of_vertices; ++v) offsets[v] = 0;
+    for (V u = 0; u < num_of_vertices; ++u) {
+        V count = adjacency_vertices[u].count();
+        V* neighbors = adjacency_vertices[u].getAllNeighbors();
+        for (V i = 0; i < count; ++i) offsets[neighbors[i] + 1]++;
+        delete[] neighbors;
+    }
+    for (V v = 0; v < num_of_vertices; ++v) offsets[v + 1] += offsets[v];
+
+    long long total = offsets[num_of_vertices];
+    V* sources = new V[total];
+    W* weights = isWeighted<W> ? new W[total] : nullptr;
+    long long* next = new long long[num_of_vertices];   ///< Fill position per target.
+    for (V v = 0; v < num_of_vertices; ++v) next[v] = offsets[v];
+    for (V u = 0; u < num_of_vertices; ++u) {
+        V count = adjacency_vertices[u].count();
+        V* neighbors = adjacency_vertices[u].getAllNeighbors();
+        W* arcWeights = adjacency_vertices[u].getAllWeights();
+        for (V i = 0; i < count; ++i) {
+            long long at = next[neighbors[i]]++;
+            sources[at] = u;
+            if constexpr (isWeighted<W>) weights[at] = arcWeights[i];
+        }
+        delete[] neighbors;
+        delete[] arcWeights;
+    }
+    delete[] next;
+
+    in_sources = sources;
+    in_weights = weights;
+    in_offsets.store(offsets, std::memory_order_release);
+    return offsets;
+}
+
+/// Discard the reverse index after a modification.
+template <typename V, typename W>
+void BasicGraph<V, W>::dropInIndex() {
+    delete[] in_offsets.load();
+    delete[] in_sources;
+    delete[] in_weights;
+    in_offsets = nullptr;
+    in_sources = nullptr;
+    in_weights = nullptr;
 }
 
 /**
- * @brief Add an undirected weighted edge between two vertices.
+ * @brief Add a weighted edge between two vertices.
+ *
+ * Undirected graphs store it in both lists, directed graphs in src's only.
  * @param src Source vertex.
  * @param dest Destination vertex.
  * @param weight Weight of the edge.
  * @note Does nothing if vertices are invalid.
  */
-void Graph::addEdge(int src, int dest, int weight) {
-    if (src < 0 || dest < 0 || src >= num_of_vertices || dest >= num_of_vertices) {
+template <typename V, typename W>
+void BasicGraph<V, W>::addEdge(V src, V dest, W weight) {
+    if (!inRange(src, num_of_vertices) || !inRange(dest, num_of_vertices)) {
         std::cout << "Invalid edge!" << std::endl;
         return;
     }
 
     adjacency_vertices[src].addEdge(dest, weight);
+    if (edge_direction == Direction::DIRECTED) {
+        dropInIndex();
+        return;
+    }
     adjacency_vertices[dest].addEdge(src, weight); ///< Because the graph is undirected.
 }
 
 /**
- * @brief Remove an undirected edge between two vertices.
+ * @brief Remove an edge between two vertices (the arc src -> dest if directed).
  * @param src Source vertex.
  * @param dest Destination vertex.
  * @throws std::runtime_error If the edge does not exist.
  */
-void Graph::removeEdge(int src, int dest) { 
-    if (src < 0 || dest < 0 || src >= num_of_vertices || dest >= num_of_vertices) {
+template <typename V, typename W>
+void BasicGraph<V, W>::removeEdge(V src, V dest) { 
+    if (!inRange(src, num_of_vertices) || !inRange(dest, num_of_vertices)) {
         std::cout << "Invalid edge!" << std::endl;
         return;
     }
@@ -56,24 +330,122 @@ void Graph::removeEdge(int src, int dest) {
     }
 
     adjacency_vertices[src].removeEdge(dest);
+    if (edge_direction == Direction::DIRECTED) {
+        dropInIndex();
+        return;
+    }
     adjacency_vertices[dest].removeEdge(src); ///< Remove both directions.
 }
 
+/**
+ * @brief Sort a batch into per-list update groups and apply each group.
+ *
+ * An undirected edge yields an update for both endpoints. Updates are
+ * stable-sorted by the vertex whose list they change, so within one list
+ * they keep the batch order.
+ * @param apply Called as apply(list, dests, weights, n) once per list.
+ * @throws std::out_of_range If an edge refers to a vertex outside the
+ *         graph; nothing is changed then.
+ */
+template <typename V, typename W>
+template <typename Apply>
+void BasicGraph<V, W>::applyGrouped(const Edge* edges, long long count, Apply apply) {
+    for (long long i = 0; i < count; ++i) {
+        if (!inRange(edges[i].src, num_of_vertices) || !inRange(edges[i].dest, num_of_vertices)) {
+            throw std::out_of_range("Invalid edge in edge list");
+        }
+    }
+
+    bool mirrored = (edge_direction == Direction::UNDIRECTED);
+    long long total = mirrored ? 2 * count : count;
+    Edge* updates = new Edge[total];        ///< src is the vertex whose list changes.
+    long long at = 0;
+    for (long long i = 0; i < count; ++i) {
+        updates[at++] = edges[i];
+        if (mirrored) updates[at++] = {edges[i].dest, edges[i].src, edges[i].weight};
+    }
+    std::stable_sort(updates, updates + total, [](const Edge& a, const Edge& b) {
+        return a.src < b.src;
+    });
+
+    V* dests = new V[total];
+    W* weights = new W[total];
+    for (long long i = 0; i < total; ++i) {
+        dests[i] = updates[i].dest;
+        weights[i] = updates[i].weight;
+    }
+    for (long long begin = 0, end; begin < total; begin = end) {
+        for (end = begin + 1; end < total && updates[end].src == updates[begin].src; ++end) {}
+        apply(adjacency_vertices[updates[begin].src], dests + begin, weights + begin,
+              static_cast<V>(end - begin));
+    }
+    delete[] updates;
+    delete[] dests;
+    delete[] weights;
+    if (edge_direction == Direction::DIRECTED) dropInIndex();
+}
+
+/**
+ * @brief Add a batch of edges.
+ *
+ * Same result as calling addEdge for each edge in order, but each
+ * adjacency list is updated once for all of its new edges.
+ * @param edges Edge triples.
+ * @param count Number of triples.
+ * @throws std::out_of_range If an edge refers to a vertex outside the
+ *         graph; no edge is added then.
+ */
+template <typename V, typename W>
+void BasicGraph<V, W>::addEdges(const Edge* edges, long long count) {
+    applyGrouped(edges, count, [](List& list, const V* dests, const W* weights, V n) {
+        list.addEdges(dests, weights, n);
+    });
+}
+
+/**
+ * @brief Remove a batch of edges (arcs if directed); weights are ignored.
+ *
+ * Each entry removes one matching edge, like removeEdge, but edges that
+ * do not exist are skipped instead of throwing, and each adjacency list is
+ * processed once for all of its removals: a list without a hash index is
+ * compacted in one traversal rather than scanned once per edge.
+ * @param edges Edges to remove.
+ * @param count Number of entries.
+ * @return Number of edges removed.
+ * @throws std::out_of_range If an edge refers to a vertex outside the
+ *         graph; nothing is removed then.
+ */
+template <typename V, typename W>
+long long BasicGraph<V, W>::removeEdges(const Edge* edges, long long count) {
+    long long removed = 0;
+    applyGrouped(edges, count, [&removed](List& list, const V* dests, const W*, V n) {
+        removed += list.removeEdges(dests, n);
+    });
+    return edge_direction == Direction::DIRECTED ? removed : removed / 2;
+}
+
 /**
  * @brief Print the entire graph.
  * 
- * Displays each vertex followed by its adjacency list.
+ * Displays each vertex followed by its adjacency list. The text is
+ * formatted into one buffer and written to std::cout in large chunks.
  */
-void Graph::print_graph() const {
-    for (int i = 0; i < num_of_vertices; ++i) {
-        std::cout << "vertex " << i << ": ";
-        adjacency_vertices[i].print();  
-        std::cout << std::endl;
+template <typename V, typename W>
+void BasicGraph<V, W>::print_graph() const {
+    OutputBuffer out(std::cout);
+    for (V i = 0; i < num_of_vertices; ++i) {
+        out.put("vertex ");
+        out.putNumber(i);
+        out.put(": ");
+        adjacency_vertices[i].print(out);
+        out.put('\n');
     }
+    out.flush();
 }
 
 /// @return Number of vertices in the graph.
-int Graph::getNumVertices() const {
+template <typename V, typename W>
+V BasicGraph<V, W>::getNumVertices() const {
     return num_of_vertices;
 }
 
@@ -82,8 +454,9 @@ int Graph::getNumVertices() const {
  * @param vertex Vertex index.
  * @return Number of neighbors, or 0 if invalid vertex.
  */
-int Graph::getNeighborCount(int vertex) const {
-    if (vertex < 0 || vertex >= num_of_vertices) return 0;
+template <typename V, typename W>
+V BasicGraph<V, W>::getNeighborCount(V vertex) const {
+    if (!inRange(vertex, num_of_vertices)) return 0;
     return adjacency_vertices[vertex].count();
 }
 
@@ -93,20 +466,36 @@ int Graph::getNeighborCount(int vertex) const {
  * @return Dynamically allocated array of neighbors, or nullptr if invalid.
  * @note Caller is responsible for freeing the array.
  */
-int* Graph::getNeighbors(int vertex) const {
-    if (vertex < 0 || vertex >= num_of_vertices) return nullptr;
+template <typename V, typename W>
+V* BasicGraph<V, W>::getNeighbors(V vertex) const {
+    if (!inRange(vertex, num_of_vertices)) return nullptr;
     return adjacency_vertices[vertex].getAllNeighbors();
 }
 
+/**
+ * @brief Get the weights of all edges leaving a vertex.
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of weights, parallel to getNeighbors(), or nullptr if invalid
+ *         or the graph is unweighted.
+ * @note Caller is responsible for freeing the array.
+ */
+template <typename V, typename W>
+W* BasicGraph<V, W>::getNeighborWeights(V vertex) const {
+    if (!inRange(vertex, num_of_vertices)) return nullptr;
+    return adjacency_vertices[vertex].getAllWeights();
+}
+
 /**
  * @brief Get the weight of an edge between two vertices.
  * @param src Source vertex.
  * @param dest Destination vertex.
- * @return Edge weight, or -1 if invalid or edge not found.
+ * @return Edge weight (1 in an unweighted graph), or none<W>() (-1 for
+ *         signed weights) if invalid or edge not found.
  */
-int Graph::getEdgeWeight(int src, int dest) const {
-    if (src < 0 || dest < 0 || src >= num_of_vertices || dest >= num_of_vertices)
-        return -1;
+template <typename V, typename W>
+WeightResult<W> BasicGraph<V, W>::getEdgeWeight(V src, V dest) const {
+    if (!inRange(src, num_of_vertices) || !inRange(dest, num_of_vertices))
+        return none<WeightResult<W>>();
     return adjacency_vertices[src].getWeight(dest);
 }
 
@@ -116,8 +505,9 @@ int Graph::getEdgeWeight(int src, int dest) const {
  * @param dest Destination vertex.
  * @return True if the edge exists, false otherwise.
  */
-bool Graph::containsEdge(int src, int dest) const {
-    if (src < 0 || dest < 0 || src >= num_of_vertices || dest >= num_of_vertices) {
+template <typename V, typename W>
+bool BasicGraph<V, W>::containsEdge(V src, V dest) const {
+    if (!inRange(src, num_of_vertices) || !inRange(dest, num_of_vertices)) {
         return false;
     }
     return adjacency_vertices[src].contains(dest);
@@ -125,18 +515,84 @@ bool Graph::containsEdge(int src, int dest) const {
 
 /**
  * @brief Count the total number of edges in the graph.
- * @return Number of undirected edges.
- */
-int Graph::countEdges() const {
-    int total = 0;
-    for (int i = 0; i < num_of_vertices; ++i) {
-        Node* current = adjacency_vertices[i].getHead();
-        while (current != nullptr) {
-            total++;
-            current = current->next;
-        }
+ * @return Number of undirected edges, or of arcs if the graph is directed.
+ */
+template <typename V, typename W>
+long long BasicGraph<V, W>::countEdges() const {
+    long long total = 0;
+    for (V i = 0; i < num_of_vertices; ++i) {
+        total += adjacency_vertices[i].count();
     }
+    if (edge_direction == Direction::DIRECTED) return total;
     return total / 2; ///< Divide by 2 since the graph is undirected.
 }
 
+/**
+ * @brief Get the number of edges entering a vertex.
+ * @param vertex Vertex index.
+ * @return In-degree (the degree if undirected), or 0 if invalid vertex.
+ */
+template <typename V, typename W>
+V BasicGraph<V, W>::getInNeighborCount(V vertex) const {
+    if (edge_direction == Direction::UNDIRECTED) return getNeighborCount(vertex);
+    if (!inRange(vertex, num_of_vertices)) return 0;
+    const long long* offsets = inIndex();
+    return static_cast<V>(offsets[vertex + 1] - offsets[vertex]);
+}
+
+/**
+ * @brief Get the sources of all edges entering a vertex.
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of sources, or nullptr if invalid.
+ * @note Caller is responsible for freeing the array. The first call after
+ *       a modification of a directed graph rebuilds the reverse index.
+ */
+template <typename V, typename W>
+V* BasicGraph<V, W>::getInNeighbors(V vertex) const {
+    if (edge_direction == Direction::UNDIRECTED) return getNeighbors(vertex);
+    if (!inRange(vertex, num_of_vertices)) return nullptr;
+    const long long* offsets = inIndex();
+
+    long long begin = offsets[vertex];
+    long long count = offsets[vertex + 1] - begin;
+    V* sources = new V[count];
+    for (long long i = 0; i < count; ++i) sources[i] = in_sources[begin + i];
+    return sources;
+}
+
+/**
+ * @brief Get the weights of all edges entering a vertex.
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of weights, parallel to getInNeighbors(), or nullptr if invalid
+ *         or the graph is unweighted.
+ * @note Caller is responsible for freeing the array.
+ */
+template <typename V, typename W>
+W* BasicGraph<V, W>::getInNeighborWeights(V vertex) const {
+    if (edge_direction == Direction::UNDIRECTED) return getNeighborWeights(vertex);
+    if (!inRange(vertex, num_of_vertices) || !isWeighted<W>) return nullptr;
+    const long long* offsets = inIndex();
+
+    long long begin = offsets[vertex];
+    long long count = offsets[vertex + 1] - begin;
+    W* weights = new W[count];
+    for (long long i = 0; i < count; ++i) weights[i] = in_weights[begin + i];
+    return weights;
+}
+
+/**
+ * @brief Get the encoding currently used by a vertex's adjacency list.
+ * @param vertex Vertex index.
+ * @return The list encoding, or LIST if invalid vertex.
+ */
+template <typename V, typename W>
+typename BasicGraph<V, W>::List::Encoding BasicGraph<V, W>::getEncoding(V vertex) const {
+    if (!inRange(vertex, num_of_vertices)) return List::Encoding::LIST;
+    return adjacency_vertices[vertex].encoding();
+}
+
+#define GRAPH_INSTANTIATE_GRAPH(V, W) template class BasicGraph<V, W>;
+GRAPH_FOR_EACH_TYPE_PAIR(GRAPH_INSTANTIATE_GRAPH)
+#undef GRAPH_INSTANTIATE_GRAPH
+
 } // namespace graph
@@ -4,37 +4,110 @@
 #define GRAPH_HPP
 
 #include "AdjacencyList.hpp"
+#include <atomic>
+#include <mutex>
 
 namespace graph {
 
+/// Whether a graph stores each edge in both directions or only from src to dest.
+enum class Direction {
+    UNDIRECTED,  ///< addEdge(u, v) links u to v and v to u.
+    DIRECTED     ///< addEdge(u, v) adds the arc u -> v only.
+};
+
+class WorkPool;
+
+/**
+ * @struct EdgeRecord
+ * @brief One (src, dest, weight) triple of an edge list.
+ */
+template <typename V, typename W>
+struct EdgeRecord {
+    V src;      ///< Source vertex.
+    V dest;     ///< Destination vertex.
+    W weight;   ///< Weight of the edge.
+};
+
 /**
- * @class Graph
- * @brief Undirected weighted graph implemented using adjacency lists.
+ * @class BasicGraph
+ * @brief Weighted graph implemented using adjacency lists.
  * 
  * Each vertex has an adjacency list storing its neighbors
- * and the weights of the connecting edges.
+ * and the weights of the connecting edges. Every list picks its own
+ * encoding from its degree according to the graph's StoragePolicy.
+ *
+ * Graphs are undirected unless constructed with Direction::DIRECTED, in
+ * which case only out-edges are stored. In-edges of a directed graph are
+ * served from a reverse index that is built on the first getInNeighbors*
+ * call and discarded on the next modification.
+ * @tparam V Vertex ID type (int, uint32_t or uint64_t).
+ * @tparam W Weight type (uint8_t, int, int64_t, float or double), or
+ *           Unweighted to store no weights at all.
  */
-class Graph {
+template <typename V, typename W>
+class BasicGraph {
+public:
+    typedef V vertex_type;  ///< Vertex ID type.
+    typedef W weight_type;  ///< Weight type.
+    typedef BasicAdjacencyList<V, W> List;  ///< Adjacency list of one vertex.
+    typedef EdgeRecord<V, W> Edge;          ///< Input record of the bulk constructor.
+
 private:
-    int num_of_vertices;             ///< Number of vertices in the graph.
-    AdjacencyList* adjacency_vertices; ///< Array of adjacency lists.
+    V num_of_vertices;               ///< Number of vertices in the graph.
+    List* adjacency_vertices;        ///< Array of adjacency lists.
+    StorageContext* storage;         ///< Encoding settings shared by the lists.
+    Direction edge_direction;        ///< Whether edges are mirrored.
+    typename List::Block* arena;     ///< Blocks allocated in one piece by the bulk constructor.
+
+    mutable std::atomic<long long*> in_offsets; ///< Start of each vertex's in-edges (nullptr until built).
+    mutable V* in_sources;           ///< Sources of the in-edges, grouped by target.
+    mutable W* in_weights;           ///< Weights parallel to in_sources (nullptr if unweighted).
+    mutable std::mutex in_lock;      ///< Held while a const query builds the index.
+
+    void build(const Edge* edges, long long count, WorkPool& pool);
+    const long long* inIndex() const;
+    void dropInIndex();
+    template <typename Apply>
+    void applyGrouped(const Edge* edges, long long count, Apply apply);
 
 public:
   
-    Graph(int vertices);
-    ~Graph();
+    BasicGraph(V vertices, const StoragePolicy& policy = StoragePolicy());
+    BasicGraph(V vertices, Direction direction, const StoragePolicy& policy = StoragePolicy());
+    BasicGraph(V vertices, const Edge* edges, long long count,
+               Direction direction = Direction::UNDIRECTED,
+               const StoragePolicy& policy = StoragePolicy(),
+               unsigned threads = 1);
+    BasicGraph(V vertices, const Edge* edges, long long count, Direction direction,
+               const StoragePolicy& policy, WorkPool& pool);
+    BasicGraph(BasicGraph&& other) noexcept;
+    BasicGraph(const BasicGraph&) = delete;
+    BasicGraph& operator=(const BasicGraph&) = delete;
+    ~BasicGraph();
 
-    void addEdge(int src, int dest, int weight = 1);
-    void removeEdge(int src, int dest);
+    void addEdge(V src, V dest, W weight = 1);
+    void removeEdge(V src, V dest);
+    void addEdges(const Edge* edges, long long count);
+    long long removeEdges(const Edge* edges, long long count);
     void print_graph() const;
-    int getNumVertices() const;
-    int getNeighborCount(int vertex) const;
-    int* getNeighbors(int vertex) const;
-    int getEdgeWeight(int src, int dest) const;
-    bool containsEdge(int src, int dest) const;
-    int countEdges() const;
+    V getNumVertices() const;
+    V getNeighborCount(V vertex) const;
+    V* getNeighbors(V vertex) const;
+    W* getNeighborWeights(V vertex) const;
+    WeightResult<W> getEdgeWeight(V src, V dest) const;
+    bool containsEdge(V src, V dest) const;
+    long long countEdges() const;
+    Direction direction() const {return edge_direction;}
+    bool isDirected() const {return edge_direction == Direction::DIRECTED;}
+    V getInNeighborCount(V vertex) const;
+    V* getInNeighbors(V vertex) const;
+    W* getInNeighborWeights(V vertex) const;
+    typename List::Encoding getEncoding(V vertex) const;
 };
 
+/// Graph with int vertex IDs and int weights.
+typedef BasicGraph<int, int> Graph;
+
 } // namespace graph
 
 #endif // GRAPH_HPP
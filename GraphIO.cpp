@@ -0,0 +1,529 @@
+// ronavraham99@gmail.com
+
+#include "GraphIO.hpp"
+#include "OutputBuffer.hpp"
+#include "Parallel.hpp"
+#include "TextScanner.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace graph {
+
+/// Chunks smaller than this are not worth a thread of their own.
+static const long long MIN_CHUNK_BYTES = 1 << 16;
+/// Whether binary files can be used in place, being little-endian.
+static const bool HOST_LITTLE_ENDIAN = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+/// Convert between host byte order and little-endian; a no-op on little-endian hosts.
+static int32_t littleEndian(int32_t value) {
+    if (HOST_LITTLE_ENDIAN) return value;
+    uint32_t bits = static_cast<uint32_t>(value);
+    return static_cast<int32_t>((bits >> 24) | ((bits >> 8) & 0xff00) | ((bits << 8) & 0xff0000) | (bits << 24));
+}
+
+/**
+ * @brief Read-only mapping of a whole file, released on destruction.
+ */
+struct MappedFile {
+    const char* data;   ///< First byte (nullptr for an empty file).
+    long long size;     ///< Length in bytes.
+
+    MappedFile(const char* path) : data(nullptr), size(0) {
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Cannot open graph file");
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot open graph file");
+        }
+        size = info.st_size;
+        if (size > 0) {
+            void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Cannot map graph file");
+            }
+            ::madvise(mapping, size, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(mapping);
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile() {
+        if (data != nullptr) ::munmap(const_cast<char*>(data), size);
+    }
+};
+
+/**
+ * @brief File opened for writing, closed on destruction.
+ */
+struct OutputFile {
+    int fd;
+
+    OutputFile(const char* path) : fd(::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) {
+        if (fd < 0) throw std::runtime_error("Cannot open graph file for writing");
+    }
+
+    ~OutputFile() {
+        if (fd >= 0) ::close(fd);
+    }
+
+    /// Close now, reporting any error.
+    void close() {
+        int status = ::close(fd);
+        fd = -1;
+        if (status != 0) throw std::runtime_error("Failed to write graph file");
+    }
+};
+
+/**
+ * @brief Growable array of parsed edges.
+ *
+ * Vertex IDs are checked against a limit and shifted by a base when pushed,
+ * so 1-based formats come out 0-based.
+ */
+struct EdgeBuffer {
+    Graph::Edge* edges = nullptr;
+    long long count = 0;
+    long long capacity = 0;
+    long long largest = -1;     ///< Largest vertex ID pushed.
+
+    ~EdgeBuffer() {
+        delete[] edges;
+    }
+
+    /**
+     * @return False if a vertex ID is outside [base, base + limit) or the
+     *         weight does not fit an int.
+     */
+    bool push(long long src, long long dest, long long weight, long long base, long long limit) {
+        src -= base;
+        dest -= base;
+        if (src < 0 || dest < 0 || src >= limit || dest >= limit) return false;
+        if (weight < INT_MIN || weight > INT_MAX) return false;
+        if (count == capacity) {
+            capacity = capacity == 0 ? 1024 : capacity * 2;
+            Graph::Edge* grown = new Graph::Edge[capacity];
+            if (count > 0) std::memcpy(grown, edges, count * sizeof(Graph::Edge));
+            delete[] edges;
+            edges = grown;
+        }
+        edges[count++] = {static_cast<int>(src), static_cast<int>(dest), static_cast<int>(weight)};
+        if (src > largest) largest = src;
+        if (dest > largest) largest = dest;
+        return true;
+    }
+};
+
+/**
+ * @brief Parse the body of a file, optionally in parallel.
+ *
+ * The range is cut into one chunk per thread, every cut moved forward to
+ * the start of a line. parseLine(scanner, buffer) is called at the start of
+ * each line and returns false if the line is malformed.
+ * @param merged Receives all edges in file order.
+ * @throws std::runtime_error If any line is malformed.
+ */
+template <typename ParseLine>
+static void parseBody(const char* begin, const char* end, unsigned threads,
+                      EdgeBuffer& merged, ParseLine parseLine) {
+    threads = workerCount(threads, (end - begin) / MIN_CHUNK_BYTES);
+    const char** cuts = new const char*[threads + 1];
+    cuts[0] = begin;
+    cuts[threads] = end;
+    for (unsigned t = 1; t < threads; ++t) {
+        Scanner in{begin + (end - begin) * t / threads, end};
+        if (in.at[-1] != '\n') in.nextLine();
+        cuts[t] = in.at < cuts[t - 1] ? cuts[t - 1] : in.at;
+    }
+
+    EdgeBuffer* parts = new EdgeBuffer[threads];
+    bool* failed = new bool[threads];
+    forEachSlice(threads, threads, [&](unsigned t, long long, long long) {
+        failed[t] = false;
+        Scanner in{cuts[t], cuts[t + 1]};
+        while (in.at < in.end) {
+            if (!parseLine(in, parts[t])) {
+                failed[t] = true;
+                return;
+            }
+            in.nextLine();
+        }
+    });
+
+    bool malformed = false;
+    long long total = 0;
+    for (unsigned t = 0; t < threads; ++t) {
+        malformed = malformed || failed[t];
+        total += parts[t].count;
+        if (parts[t].largest > merged.largest) merged.largest = parts[t].largest;
+    }
+    if (!malformed && threads == 1) {
+        std::swap(merged.edges, parts[0].edges);
+        merged.count = merged.capacity = total;
+    } else if (!malformed) {
+        merged.edges = new Graph::Edge[total];
+        merged.count = merged.capacity = total;
+        long long at = 0;
+        for (unsigned t = 0; t < threads; ++t) {
+            if (parts[t].count > 0) {
+                std::memcpy(merged.edges + at, parts[t].edges, parts[t].count * sizeof(Graph::Edge));
+            }
+            at += parts[t].count;
+        }
+    }
+    delete[] cuts;
+    delete[] parts;
+    delete[] failed;
+    if (malformed) throw std::runtime_error("Malformed line in graph file");
+}
+
+/**
+ * @brief Load a whitespace-separated edge list (SNAP style).
+ *
+ * Each line is "src dest" or "src dest weight" with 0-based vertex IDs;
+ * missing weights are 1. Blank lines and lines starting with '#' or '%'
+ * are skipped. The graph has one vertex more than the largest ID seen.
+ * @param path File to read.
+ * @param direction Whether each line is an undirected edge or an arc.
+ * @param threads Parser and construction threads (0 for one per hardware thread).
+ * @return The loaded graph.
+ * @throws std::runtime_error If the file cannot be read or a line is malformed.
+ */
+Graph readEdgeList(const char* path, Direction direction, unsigned threads) {
+    MappedFile file(path);
+    EdgeBuffer edges;
+    parseBody(file.data, file.data + file.size, threads, edges, [](Scanner& in, EdgeBuffer& out) {
+        long long src, dest, weight;
+        Scanner::LineKind kind = in.readEdgeLine(src, dest, weight);
+        return kind == Scanner::NONE || (kind == Scanner::EDGE && out.push(src, dest, weight, 0, INT_MAX));
+    });
+    return Graph(static_cast<int>(edges.largest + 1), edges.edges, edges.count,
+                 direction, StoragePolicy(), threads);
+}
+
+/**
+ * @brief Load a DIMACS shortest-path graph (.gr).
+ *
+ * The file has a problem line "p sp vertices arcs" followed by arc lines
+ * "a src dest weight" with 1-based vertex IDs; lines starting with 'c' are
+ * comments.
+ * @param path File to read.
+ * @param direction DIMACS lists arcs, so the graph is directed by default.
+ * @param threads Parser and construction threads (0 for one per hardware thread).
+ * @return The loaded graph.
+ * @throws std::runtime_error If the file cannot be read, the problem line
+ *         is missing, or a line is malformed.
+ */
+Graph readDimacs(const char* path, Direction direction, unsigned threads) {
+    MappedFile file(path);
+    Scanner header{file.data, file.data + file.size};
+    long long vertices = -1, arcs;
+    while (header.at < header.end) {
+        if (header.atLineEnd() || *header.at == 'c') {
+            header.nextLine();
+            continue;
+        }
+        if (*header.at++ != 'p' || !header.readWord("sp") || !header.readInt(vertices) ||
+            !header.readInt(arcs) || !header.atLineEnd() || vertices < 0 || vertices > INT_MAX) {
+            throw std::runtime_error("Malformed DIMACS problem line");
+        }
+        header.nextLine();
+        break;
+    }
+    if (vertices < 0) throw std::runtime_error("Missing DIMACS problem line");
+
+    EdgeBuffer edges;
+    parseBody(header.at, header.end, threads, edges, [vertices](Scanner& in, EdgeBuffer& out) {
+        if (in.atLineEnd() || *in.at == 'c') return true;
+        if (*in.at++ != 'a') return false;
+        long long src, dest, weight;
+        if (!in.readInt(src) || !in.readInt(dest) || !in.readInt(weight) || !in.atLineEnd()) return false;
+        return out.push(src, dest, weight, 1, vertices);
+    });
+    return Graph(static_cast<int>(vertices), edges.edges, edges.count, direction, StoragePolicy(), threads);
+}
+
+/**
+ * @brief Load a square Matrix Market coordinate matrix as a graph.
+ *
+ * Entry (i, j) becomes an edge from i - 1 to j - 1. Symmetric matrices list
+ * each edge once and load as an undirected graph; general matrices load as
+ * a directed graph. Pattern matrices get weight 1.
+ * @param path File to read.
+ * @param threads Parser and construction threads (0 for one per hardware thread).
+ * @return The loaded graph.
+ * @throws std::runtime_error If the file cannot be read, is not a square
+ *         pattern or integer coordinate matrix with general or symmetric
+ *         symmetry, or a line is malformed.
+ */
+Graph readMatrixMarket(const char* path, unsigned threads) {
+    MappedFile file(path);
+    Scanner header{file.data, file.data + file.size};
+    if (!header.readWord("%%matrixmarket") || !header.readWord("matrix") ||
+        !header.readWord("coordinate")) {
+        throw std::runtime_error("Unsupported Matrix Market file");
+    }
+    Scanner field = header;
+    bool pattern = header.readWord("pattern");
+    if (!pattern && !(header = field).readWord("integer")) {
+        throw std::runtime_error("Unsupported Matrix Market field, expected pattern or integer");
+    }
+    Scanner symmetry = header;
+    Direction direction = Direction::DIRECTED;
+    if (header.readWord("symmetric")) {
+        direction = Direction::UNDIRECTED;
+    } else if (!(header = symmetry).readWord("general")) {
+        throw std::runtime_error("Unsupported Matrix Market symmetry, expected general or symmetric");
+    }
+    header.nextLine();
+
+    long long rows = -1, columns, entries;
+    while (header.at < header.end) {
+        if (header.atLineEnd() || *header.at == '%') {
+            header.nextLine();
+            continue;
+        }
+        if (!header.readInt(rows) || !header.readInt(columns) || !header.readInt(entries) ||
+            !header.atLineEnd() || rows != columns || rows < 0 || rows > INT_MAX) {
+            throw std::runtime_error("Matrix Market size line must describe a square matrix");
+        }
+        header.nextLine();
+        break;
+    }
+    if (rows < 0) throw std::runtime_error("Missing Matrix Market size line");
+
+    EdgeBuffer edges;
+    parseBody(header.at, header.end, threads, edges, [rows, pattern](Scanner& in, EdgeBuffer& out) {
+        if (in.atLineEnd() || *in.at == '%') return true;
+        long long src, dest, weight = 1;
+        if (!in.readInt(src) || !in.readInt(dest)) return false;
+        if (!pattern && !in.readInt(weight)) return false;
+        return in.atLineEnd() && out.push(src, dest, weight, 1, rows);
+    });
+    return Graph(static_cast<int>(rows), edges.edges, edges.count, direction, StoragePolicy(), threads);
+}
+
+/**
+ * @brief Call body(src, dest, weight) once per edge of a graph.
+ *
+ * Undirected edges are reported from their smaller endpoint. A self-loop
+ * appears twice in its vertex's list, so every second occurrence is skipped.
+ */
+template <typename Body>
+static void forEachEdge(const Graph& g, Body body) {
+    for (int v = 0; v < g.getNumVertices(); ++v) {
+        int count = g.getNeighborCount(v);
+        int* neighbors = g.getNeighbors(v);
+        int* weights = g.getNeighborWeights(v);
+        bool pendingLoop = false;
+        for (int i = 0; i < count; ++i) {
+            int u = neighbors[i];
+            if (u == v) pendingLoop = !pendingLoop;
+            if (g.isDirected() || v < u || (u == v && pendingLoop)) body(v, u, weights[i]);
+        }
+        delete[] neighbors;
+        delete[] weights;
+    }
+}
+
+/**
+ * @brief Load an undirected graph in METIS format.
+ *
+ * After '%' comment lines, the header is "vertices edges [fmt [ncon]]",
+ * and line i (1-based) of the rest lists the neighbors of vertex i. fmt's
+ * three digits, each 0 or 1, flag vertex sizes, vertex weights and edge
+ * weights; vertex sizes and weights are skipped, and edges without a
+ * weight get weight 1. Every edge is listed from both endpoints and added
+ * once.
+ * @param path File to read.
+ * @return The loaded graph.
+ * @throws std::runtime_error If the file cannot be read or is malformed,
+ *         including self-loops and edge counts that disagree with the header.
+ */
+Graph readMetis(const char* path) {
+    MappedFile file(path);
+    Scanner in{file.data, file.data + file.size};
+    while (in.at < in.end && *in.at == '%') in.nextLine();
+    long long vertices, edges, format = 0, constraints = 1;
+    if (!in.readInt(vertices) || !in.readInt(edges) || vertices < 0 || vertices > INT_MAX) {
+        throw std::runtime_error("Malformed METIS header");
+    }
+    if (!in.atLineEnd() && !in.readInt(format)) throw std::runtime_error("Malformed METIS header");
+    if (!in.atLineEnd() && !in.readInt(constraints)) throw std::runtime_error("Malformed METIS header");
+    bool edgeWeights = format % 10 == 1;
+    bool vertexWeights = format / 10 % 10 == 1;
+    bool vertexSizes = format / 100 % 10 == 1;
+    bool flagsOnly = format % 10 <= 1 && format / 10 % 10 <= 1 && format / 100 % 10 <= 1;   ///< Every digit 0 or 1.
+    if (!in.atLineEnd() || format < 0 || format > 111 || !flagsOnly || constraints < 1) {
+        throw std::runtime_error("Malformed METIS header");
+    }
+    in.nextLine();
+
+    EdgeBuffer buffer;
+    long long listed = 0;     ///< Adjacency entries, two per edge.
+    for (long long v = 1; v <= vertices && in.at < in.end; ++v) {
+        while (in.at < in.end && *in.at == '%') in.nextLine();
+        long long skipped;
+        for (long long i = (vertexSizes ? 1 : 0) + (vertexWeights ? constraints : 0); i > 0; --i) {
+            if (!in.readInt(skipped)) throw std::runtime_error("Malformed line in graph file");
+        }
+        while (!in.atLineEnd()) {
+            long long u, weight = 1;
+            if (!in.readInt(u) || (edgeWeights && !in.readInt(weight)) || u < 1 || u > vertices ||
+                u == v || (v < u && !buffer.push(v, u, weight, 1, vertices))) {
+                throw std::runtime_error("Malformed line in graph file");
+            }
+            ++listed;
+        }
+        in.nextLine();
+    }
+    while (in.at < in.end) {
+        if (!in.atLineEnd() && *in.at != '%') throw std::runtime_error("Malformed line in graph file");
+        in.nextLine();
+    }
+    if (listed != 2 * edges || buffer.count != edges) {
+        throw std::runtime_error("METIS edge count does not match the header");
+    }
+    return Graph(static_cast<int>(vertices), buffer.edges, buffer.count);
+}
+
+/**
+ * @brief Write an undirected graph in METIS format with edge weights (fmt 001).
+ * @param g Graph to save.
+ * @param path Output file, replaced if it exists.
+ * @throws std::invalid_argument If the graph is directed or has a self-loop
+ *         or parallel edges, which METIS cannot represent.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+void writeMetis(const Graph& g, const char* path) {
+    if (g.isDirected()) throw std::invalid_argument("METIS needs an undirected graph");
+    for (int v = 0; v < g.getNumVertices(); ++v) {
+        int count = g.getNeighborCount(v);
+        int* neighbors = g.getNeighbors(v);
+        std::sort(neighbors, neighbors + count);
+        const char* error = nullptr;
+        for (int i = 0; i < count && error == nullptr; ++i) {
+            if (neighbors[i] == v) error = "METIS does not allow self-loops";
+            if (i > 0 && neighbors[i] == neighbors[i - 1]) error = "METIS does not allow parallel edges";
+        }
+        delete[] neighbors;
+        if (error != nullptr) throw std::invalid_argument(error);
+    }
+
+    OutputFile file(path);
+    OutputBuffer out(file.fd);
+    out.putInt(g.getNumVertices());
+    out.put(' ');
+    out.putInt(g.countEdges());
+    out.put(" 001\n");
+    for (int v = 0; v < g.getNumVertices(); ++v) {
+        int count = g.getNeighborCount(v);
+        int* neighbors = g.getNeighbors(v);
+        int* weights = g.getNeighborWeights(v);
+        for (int i = 0; i < count; ++i) {
+            if (i > 0) out.put(' ');
+            out.putInt(neighbors[i] + 1);
+            out.put(' ');
+            out.putInt(weights[i]);
+        }
+        out.put('\n');
+        delete[] neighbors;
+        delete[] weights;
+    }
+    out.flush();
+    file.close();
+}
+
+/**
+ * @brief Load a raw binary edge list.
+ *
+ * The file is a sequence of little-endian int32 records, (src, dest,
+ * weight) or, if unweighted, (src, dest) with weight 1. On a little-endian
+ * host weighted records have the layout of Graph::Edge and are not
+ * copied; a big-endian host copies them with the bytes swapped. The graph
+ * has one vertex more than the largest ID seen.
+ * @param path File to read.
+ * @param direction Whether each record is an undirected edge or an arc.
+ * @param weighted Whether records carry a weight.
+ * @param threads Scan and construction threads (0 for one per hardware thread).
+ * @return The loaded graph.
+ * @throws std::runtime_error If the file cannot be read, its size is not a
+ *         whole number of records, or a vertex ID is negative.
+ */
+Graph readBinaryEdgeList(const char* path, Direction direction, bool weighted, unsigned threads) {
+    static_assert(sizeof(Graph::Edge) == 3 * sizeof(int32_t), "Graph::Edge must match the record layout");
+    MappedFile file(path);
+    long long recordBytes = (weighted ? 3 : 2) * sizeof(int32_t);
+    if (file.size % recordBytes != 0) throw std::runtime_error("Truncated binary edge list");
+    long long count = file.size / recordBytes;
+    const int32_t* records = reinterpret_cast<const int32_t*>(file.data);
+
+    EdgeBuffer expanded;
+    const Graph::Edge* edges = reinterpret_cast<const Graph::Edge*>(records);
+    if ((!weighted || !HOST_LITTLE_ENDIAN) && count > 0) {
+        int fields = weighted ? 3 : 2;
+        expanded.edges = new Graph::Edge[count];
+        expanded.count = expanded.capacity = count;
+        for (long long i = 0; i < count; ++i) {
+            const int32_t* record = records + fields * i;
+            expanded.edges[i] = {littleEndian(record[0]), littleEndian(record[1]),
+                                 weighted ? littleEndian(record[2]) : 1};
+        }
+        edges = expanded.edges;
+    }
+
+    unsigned scanners = workerCount(threads, count);
+    int* largest = new int[scanners];
+    bool* negative = new bool[scanners];
+    forEachSlice(scanners, count, [&](unsigned t, long long begin, long long end) {
+        int local = -1;
+        bool below = false;
+        for (long long i = begin; i < end; ++i) {
+            local = std::max(local, std::max(edges[i].src, edges[i].dest));
+            below = below || edges[i].src < 0 || edges[i].dest < 0;
+        }
+        largest[t] = local;
+        negative[t] = below;
+    });
+    long long vertices = 0;
+    bool invalid = false;
+    for (unsigned t = 0; t < scanners; ++t) {
+        vertices = std::max(vertices, largest[t] + 1LL);
+        invalid = invalid || negative[t];
+    }
+    delete[] largest;
+    delete[] negative;
+    if (invalid || vertices > INT_MAX) throw std::runtime_error("Vertex ID out of range in binary edge list");
+    return Graph(static_cast<int>(vertices), edges, count, direction, StoragePolicy(), threads);
+}
+
+/**
+ * @brief Write a graph as a raw binary edge list.
+ *
+ * Each undirected edge is written once, each arc of a directed graph once,
+ * as little-endian int32 values whatever the host's byte order.
+ * @param g Graph to save.
+ * @param path Output file, replaced if it exists.
+ * @param weighted Whether to write (src, dest, weight) records or (src, dest) pairs.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+void writeBinaryEdgeList(const Graph& g, const char* path, bool weighted) {
+    OutputFile file(path);
+    OutputBuffer out(file.fd);
+    forEachEdge(g, [&](int src, int dest, int weight) {
+        int32_t record[3] = {littleEndian(src), littleEndian(dest), littleEndian(weight)};
+        out.write(record, (weighted ? 3 : 2) * sizeof(int32_t));
+    });
+    out.flush();
+    file.close();
+}
+
+} // namespace graph
@@ -0,0 +1,44 @@
+// ronavraham99@gmail.com
+
+#ifndef GRAPH_IO_HPP
+#define GRAPH_IO_HPP
+
+#include "Graph.hpp"
+
+namespace graph {
+
+/**
+ * @brief Graph file readers and writers.
+ *
+ * Files are mapped with mmap and parsed by a hand-written integer scanner
+ * instead of iostream. With more than one thread the file is cut into
+ * chunks that start and end on line boundaries, each chunk is parsed into
+ * its own edge buffer, and the buffers are concatenated in file order, so
+ * the graph is the same whatever the thread count. The edges are then
+ * handed to Graph's bulk constructor with the same thread count.
+ *
+ * METIS files are read serially, since each line belongs to the vertex
+ * with its line number. Binary edge lists hold little-endian int32
+ * records; on little-endian hosts they are passed to the bulk
+ * constructor straight from the mapping, and byte-swapped elsewhere.
+ *
+ * All loaders throw std::runtime_error if the file cannot be read or is
+ * malformed, including vertex IDs outside the graph. Writers stream the
+ * graph through a fixed-size buffer and throw std::runtime_error if the
+ * file cannot be written.
+ */
+
+Graph readEdgeList(const char* path, Direction direction = Direction::UNDIRECTED, unsigned threads = 1);
+Graph readDimacs(const char* path, Direction direction = Direction::DIRECTED, unsigned threads = 1);
+Graph readMatrixMarket(const char* path, unsigned threads = 1);
+
+Graph readMetis(const char* path);
+void writeMetis(const Graph& g, const char* path);
+
+Graph readBinaryEdgeList(const char* path, Direction direction = Direction::UNDIRECTED,
+                         bool weighted = true, unsigned threads = 1);
+void writeBinaryEdgeList(const Graph& g, const char* path, bool weighted = true);
+
+} // namespace graph
+
+#endif // GRAPH_IO_HPP
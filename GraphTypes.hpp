@@ -0,0 +1,95 @@
+// ronavraham99@gmail.com
+
+#ifndef GRAPH_TYPES_HPP
+#define GRAPH_TYPES_HPP
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace graph {
+
+/**
+ * @brief Vertex ID / weight type pairs the library is instantiated for.
+ *
+ * X-macro: expands X(vertex_type, weight_type) once per supported pair.
+ * Vertex IDs are int, uint32_t or uint64_t; weights are uint8_t, int,
+ * int64_t, float, double or Unweighted.
+ */
+#define GRAPH_FOR_EACH_TYPE_PAIR(X) \
+    X(int, int)              X(int, uint8_t)           X(int, int64_t) \
+    X(int, float)            X(int, double) \
+    X(uint32_t, int)         X(uint32_t, uint8_t)      X(uint32_t, int64_t) \
+    X(uint32_t, float)       X(uint32_t, double) \
+    X(uint64_t, int)         X(uint64_t, uint8_t)      X(uint64_t, int64_t) \
+    X(uint64_t, float)       X(uint64_t, double) \
+    X(int, Unweighted)       X(uint32_t, Unweighted)   X(uint64_t, Unweighted)
+
+/**
+ * @brief Weight type tag for unweighted graphs.
+ *
+ * Graphs over Unweighted store no weights at all; every edge counts as
+ * weight 1. It converts from int, so addEdge(u, v, w) still compiles and
+ * simply ignores w.
+ */
+struct Unweighted {
+    constexpr Unweighted() {}
+    constexpr Unweighted(int) {}
+    constexpr operator int() const { return 1; }
+};
+
+/// Whether graphs over weight type W store per-edge weights.
+template <typename W>
+constexpr bool isWeighted = !std::is_same<W, Unweighted>::value;
+
+/**
+ * @brief Type returned by single-edge weight queries.
+ *
+ * W itself, or int for unweighted graphs, so a missing edge can still
+ * report -1 next to the 1 of an existing one.
+ */
+template <typename W>
+using WeightResult = typename std::conditional<isWeighted<W>, W, int>::type;
+
+/**
+ * @brief Check that a vertex ID lies in [0, count).
+ * @param v Vertex ID.
+ * @param count Number of vertices.
+ * @return True if v is a valid vertex.
+ */
+template <typename V>
+inline bool inRange(V v, V count) {
+    if constexpr (std::is_signed<V>::value) {
+        if (v < 0) return false;
+    }
+    return v < count;
+}
+
+/**
+ * @brief Value returned for "no vertex" / "no such edge" (-1 converted to T).
+ *
+ * For unsigned types this is the largest value of the type.
+ */
+template <typename T>
+constexpr T none() {
+    return static_cast<T>(-1);
+}
+
+/**
+ * @brief Type used to accumulate path lengths of weight type W.
+ *
+ * 64-bit integers for integral weights, double for floating-point
+ * weights, so long paths do not overflow the weight type itself.
+ */
+template <typename W>
+using DistanceOf = typename std::conditional<std::is_floating_point<W>::value, double, long long>::type;
+
+/// "Infinite" distance for a distance type.
+template <typename D>
+constexpr D infinity() {
+    return std::numeric_limits<D>::max();
+}
+
+} // namespace graph
+
+#endif // GRAPH_TYPES_HPP
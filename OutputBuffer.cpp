@@ -0,0 +1,162 @@
+// ronavraham99@gmail.com
+
+#include "OutputBuffer.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace graph {
+
+/// "00" through "99", so numbers are formatted two digits per division.
+static const char DIGIT_PAIRS[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/**
+ * @brief Format into a caller-supplied buffer with no sink.
+ * @param buffer Buffer to fill; it must outlive the OutputBuffer.
+ * @param capacity Size of the buffer in bytes.
+ */
+OutputBuffer::OutputBuffer(char* buffer, size_t capacity)
+    : data(buffer), capacity(capacity), used(0), owned(false), fd(-1), stream(nullptr) {}
+
+/**
+ * @brief Format into an owned buffer that is flushed to a file descriptor.
+ * @param fd Open file descriptor; it is not closed by the OutputBuffer.
+ * @param capacity Buffer size in bytes.
+ */
+OutputBuffer::OutputBuffer(int fd, size_t capacity)
+    : data(new char[capacity]), capacity(capacity), used(0), owned(true), fd(fd), stream(nullptr) {}
+
+/**
+ * @brief Format into an owned buffer that is flushed to a stream.
+ * @param stream Output stream, e.g. std::cout.
+ * @param capacity Buffer size in bytes.
+ */
+OutputBuffer::OutputBuffer(std::ostream& stream, size_t capacity)
+    : data(new char[capacity]), capacity(capacity), used(0), owned(true), fd(-1), stream(&stream) {}
+
+/// Destructor – flushes to the sink, ignoring errors, and frees an owned buffer.
+OutputBuffer::~OutputBuffer() {
+    try {
+        flush();
+    } catch (...) {
+    }
+    if (owned) delete[] data;
+}
+
+/**
+ * @brief Write bytes straight to the sink.
+ * @throws std::runtime_error If the sink fails.
+ */
+void OutputBuffer::send(const char* bytes, size_t length) {
+    if (stream != nullptr) {
+        stream->write(bytes, length);
+        if (!*stream) throw std::runtime_error("Failed to write output stream");
+        return;
+    }
+    size_t written = 0;
+    while (written < length) {
+        ssize_t step = ::write(fd, bytes + written, length - written);
+        if (step < 0 && errno == EINTR) continue;
+        if (step <= 0) throw std::runtime_error("Failed to write output file");
+        written += step;
+    }
+}
+
+/// Hand the buffered bytes to the sink; a buffer without a sink keeps them.
+void OutputBuffer::drain() {
+    if (stream == nullptr && fd < 0) return;
+    send(data, used);
+    used = 0;
+}
+
+/**
+ * @brief Make room for a number of bytes.
+ * @throws std::length_error If a buffer without a sink would overflow.
+ */
+void OutputBuffer::reserve(size_t bytes) {
+    if (used + bytes <= capacity) return;
+    if (stream == nullptr && fd < 0) throw std::length_error("Output buffer is full");
+    drain();
+}
+
+/**
+ * @brief Write the buffered bytes to the sink and flush a stream sink.
+ *
+ * Does nothing for a buffer without a sink.
+ * @throws std::runtime_error If the sink fails.
+ */
+void OutputBuffer::flush() {
+    drain();
+    if (stream != nullptr) stream->flush();
+}
+
+/**
+ * @brief Append raw bytes.
+ *
+ * Runs longer than the buffer go to the sink directly.
+ */
+void OutputBuffer::write(const void* bytes, size_t length) {
+    if (length > capacity && (stream != nullptr || fd >= 0)) {
+        drain();
+        send(static_cast<const char*>(bytes), length);
+        return;
+    }
+    reserve(length);
+    std::memcpy(data + used, bytes, length);
+    used += length;
+}
+
+/// Append one character.
+void OutputBuffer::put(char c) {
+    reserve(1);
+    data[used++] = c;
+}
+
+/// Append a NUL-terminated string.
+void OutputBuffer::put(const char* text) {
+    write(text, std::strlen(text));
+}
+
+/// Append a signed decimal integer.
+void OutputBuffer::putInt(long long value) {
+    if (value < 0) {
+        put('-');
+        putUnsigned(0ULL - static_cast<unsigned long long>(value));
+    } else {
+        putUnsigned(value);
+    }
+}
+
+/// Append an unsigned decimal integer.
+void OutputBuffer::putUnsigned(unsigned long long value) {
+    char digits[20];
+    char* end = digits + sizeof(digits);
+    char* at = end;
+    while (value >= 100) {
+        unsigned pair = static_cast<unsigned>(value % 100) * 2;
+        value /= 100;
+        *--at = DIGIT_PAIRS[pair + 1];
+        *--at = DIGIT_PAIRS[pair];
+    }
+    if (value >= 10) {
+        *--at = DIGIT_PAIRS[value * 2 + 1];
+        *--at = DIGIT_PAIRS[value * 2];
+    } else {
+        *--at = static_cast<char>('0' + value);
+    }
+    write(at, end - at);
+}
+
+/// Append a floating-point value formatted like std::ostream's default (%g).
+void OutputBuffer::putReal(double value) {
+    char text[32];
+    int length = std::snprintf(text, sizeof(text), "%g", value);
+    write(text, length);
+}
+
+} // namespace graph
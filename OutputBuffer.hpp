@@ -0,0 +1,76 @@
+// ronavraham99@gmail.com
+
+#ifndef OUTPUT_BUFFER_HPP
+#define OUTPUT_BUFFER_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <type_traits>
+
+namespace graph {
+
+/**
+ * @class OutputBuffer
+ * @brief Text and byte formatter that writes into one large buffer.
+ *
+ * Numbers are formatted in place by a table-driven routine instead of
+ * through iostream. The buffer goes to its sink only when it is full or
+ * flush() is called, so large outputs cost a few big writes. Sinks are:
+ *  - a caller-supplied buffer with no sink; the text stays in the buffer
+ *    and overflowing it throws std::length_error;
+ *  - a file descriptor, written with write(2);
+ *  - a std::ostream, written with one write() per flush.
+ *
+ * The destructor flushes but cannot report errors; call flush() first to
+ * have a failed write throw std::runtime_error.
+ */
+class OutputBuffer {
+public:
+    static const size_t DEFAULT_CAPACITY = 1 << 20;   ///< 1 MiB.
+
+private:
+    char* data;              ///< Start of the buffer.
+    size_t capacity;         ///< Size of the buffer.
+    size_t used;             ///< Bytes formatted and not yet flushed.
+    bool owned;              ///< Whether the buffer is freed on destruction.
+    int fd;                  ///< File descriptor sink, or -1.
+    std::ostream* stream;    ///< Stream sink, or nullptr.
+
+    void send(const char* bytes, size_t length);
+    void drain();
+    void reserve(size_t bytes);
+
+public:
+    OutputBuffer(char* buffer, size_t capacity);
+    OutputBuffer(int fd, size_t capacity = DEFAULT_CAPACITY);
+    OutputBuffer(std::ostream& stream, size_t capacity = DEFAULT_CAPACITY);
+    ~OutputBuffer();
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    void flush();
+    void write(const void* bytes, size_t length);
+    void put(char c);
+    void put(const char* text);
+    void putInt(long long value);
+    void putUnsigned(unsigned long long value);
+    void putReal(double value);
+
+    /// Append any vertex or weight value; uint8_t prints as a number, Unweighted as 1.
+    template <typename T>
+    void putNumber(T value) {
+        if constexpr (std::is_floating_point<T>::value) putReal(value);
+        else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) putInt(value);
+        else if constexpr (std::is_integral<T>::value) putUnsigned(value);
+        else putInt(static_cast<int>(value));
+    }
+
+    /// @return Start of the buffered text (all of it, for a buffer without a sink).
+    const char* text() const {return data;}
+    /// @return Number of buffered bytes.
+    size_t size() const {return used;}
+};
+
+} // namespace graph
+
+#endif // OUTPUT_BUFFER_HPP
@@ -0,0 +1,496 @@
+// ronavraham99@gmail.com
+
+#include "PCSRGraph.hpp"
+#include "Dump.hpp"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace graph {
+
+/// slot_dest of a gap; row sentinels are stored as -2 - vertex.
+static const int EMPTY = -1;
+/// Smallest slot array.
+static const int MIN_CAPACITY = 16;
+/// Smallest leaf segment, as log2 of its size.
+static const int MIN_SEGMENT_SHIFT = 3;
+
+/// Highest density of a full leaf and of the whole array.
+static const double LEAF_UPPER = 1.0;
+static const double ROOT_UPPER = 0.75;
+/// Lowest density of a leaf and of the whole array.
+static const double LEAF_LOWER = 0.125;
+static const double ROOT_LOWER = 0.25;
+
+/// @return True if a slot holds a row sentinel.
+static bool isSentinel(int dest) {
+    return dest < EMPTY;
+}
+
+/// @return log2 of a power of two.
+static int log2Of(int value) {
+    int shift = 0;
+    while ((1 << shift) < value) ++shift;
+    return shift;
+}
+
+/**
+ * @brief Density bound of a window, interpolated between leaf and root.
+ * @param level Window height above the leaves (0 for a single leaf).
+ * @param height Height of the root window.
+ */
+static double bound(double leaf, double root, int level, int height) {
+    return height == 0 ? root : leaf + (root - leaf) * level / height;
+}
+
+/// @return Slots for a number of elements, at most half full.
+static int capacityFor(long long elements) {
+    int capacity = MIN_CAPACITY;
+    while (capacity < 2 * elements) capacity *= 2;
+    return capacity;
+}
+
+/**
+ * @brief Set up an empty graph: one sentinel per vertex and no edges.
+ * @param vertices Number of vertices in the graph.
+ * @param direction Whether edges are stored in both directions.
+ */
+void PCSRGraph::init(int vertices, Direction direction) {
+    num_of_vertices = vertices;
+    edge_direction = direction;
+    arcs = 0;
+    capacity = 0;
+    slot_dest = nullptr;
+    slot_weight = nullptr;
+    leaf_used = nullptr;
+    starts = new int[vertices];
+    degrees = new int[vertices];
+    for (int v = 0; v < vertices; ++v) degrees[v] = 0;
+}
+
+/**
+ * @brief Construct an empty PCSR graph.
+ * @param vertices Number of vertices in the graph.
+ * @param direction Whether edges are stored in both directions.
+ */
+PCSRGraph::PCSRGraph(int vertices, Direction direction) {
+    init(vertices, direction);
+    int* sentinels = new int[vertices];
+    for (int v = 0; v < vertices; ++v) sentinels[v] = -2 - v;
+    layout(capacityFor(vertices), sentinels, sentinels, vertices);
+    delete[] sentinels;
+}
+
+/**
+ * @brief Build a PCSR copy of a graph in one pass.
+ *
+ * The copy has the same direction, parallel edges and self-loops as the
+ * source; each row is sorted by destination.
+ * @param g Graph to copy.
+ */
+PCSRGraph::PCSRGraph(const Graph& g) {
+    init(g.getNumVertices(), g.direction());
+    for (int v = 0; v < num_of_vertices; ++v) {
+        degrees[v] = g.getNeighborCount(v);
+        arcs += degrees[v];
+    }
+
+    long long elements = num_of_vertices + arcs;
+    int* dests = new int[elements];
+    int* weights = new int[elements];
+    int at = 0;
+    for (int v = 0; v < num_of_vertices; ++v) {
+        dests[at] = -2 - v;
+        weights[at++] = 0;
+        int* neighbors = g.getNeighbors(v);
+        int* w = g.getNeighborWeights(v);
+        int* order = new int[degrees[v]];
+        for (int i = 0; i < degrees[v]; ++i) order[i] = i;
+        std::stable_sort(order, order + degrees[v], [neighbors](int a, int b) {
+            return neighbors[a] < neighbors[b];
+        });
+        for (int i = 0; i < degrees[v]; ++i) {
+            dests[at] = neighbors[order[i]];
+            weights[at++] = w[order[i]];
+        }
+        delete[] order;
+        delete[] neighbors;
+        delete[] w;
+    }
+    layout(capacityFor(elements), dests, weights, at);
+    delete[] dests;
+    delete[] weights;
+}
+
+/// Destructor – releases the slot array and vertex tables.
+PCSRGraph::~PCSRGraph() {
+    delete[] slot_dest;
+    delete[] slot_weight;
+    delete[] leaf_used;
+    delete[] starts;
+    delete[] degrees;
+}
+
+/// @return True if both endpoints are valid vertices.
+bool PCSRGraph::isValid(int src, int dest) const {
+    return src >= 0 && dest >= 0 && src < num_of_vertices && dest < num_of_vertices;
+}
+
+/// @return Slot just past the row of a vertex.
+int PCSRGraph::rowEnd(int vertex) const {
+    return vertex + 1 < num_of_vertices ? starts[vertex + 1] : capacity;
+}
+
+/**
+ * @brief Binary search a row, stepping over gaps.
+ *
+ * A probe that lands in a gap moves to the last element of its leaf, or
+ * of the nearest non-empty leaf before it, which is the nearest element
+ * before the probe.
+ * @return Slot of the last edge with destination <= dest, or the row's
+ *         sentinel if there is none.
+ */
+int PCSRGraph::lastAtMost(int vertex, int dest) const {
+    int after = starts[vertex];
+    int lo = after + 1;
+    int hi = rowEnd(vertex) - 1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        int probe = mid;
+        if (slot_dest[probe] == EMPTY) {
+            int leaf = probe >> segment_shift;
+            while (leaf_used[leaf] == 0 && (leaf << segment_shift) > lo) --leaf;   ///< Skip empty leaves.
+            probe = (leaf << segment_shift) + leaf_used[leaf] - 1;
+        }
+        if (probe < lo) {
+            lo = mid + 1;
+        } else if (slot_dest[probe] <= dest) {
+            after = probe;
+            lo = mid + 1;
+        } else {
+            hi = probe - 1;
+        }
+    }
+    return after;
+}
+
+/// @return Slot of an edge src -> dest (the newest parallel copy), or -1.
+int PCSRGraph::find(int src, int dest) const {
+    int slot = lastAtMost(src, dest);
+    return slot != starts[src] && slot_dest[slot] == dest ? slot : -1;
+}
+
+/// Move one element to another slot, keeping its row's sentinel index current.
+void PCSRGraph::moveSlot(int from, int to) {
+    slot_dest[to] = slot_dest[from];
+    slot_weight[to] = slot_weight[from];
+    if (isSentinel(slot_dest[to])) starts[-2 - slot_dest[to]] = to;
+}
+
+/**
+ * @brief Copy the elements of a window of leaves out in order.
+ * @param after Slot after which (dest, weight) is inserted, or -1 for none.
+ * @return Number of elements copied.
+ */
+int PCSRGraph::gather(int firstLeaf, int leaves, int* dests, int* weights,
+                      int after, int dest, int weight) const {
+    int count = 0;
+    for (int leaf = firstLeaf; leaf < firstLeaf + leaves; ++leaf) {
+        int begin = leaf << segment_shift;
+        for (int slot = begin; slot < begin + leaf_used[leaf]; ++slot) {
+            dests[count] = slot_dest[slot];
+            weights[count++] = slot_weight[slot];
+            if (slot == after) {
+                dests[count] = dest;
+                weights[count++] = weight;
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Write elements evenly over a window of leaves.
+ *
+ * Each leaf gets count / leaves elements (the first count % leaves one
+ * more), packed at its start.
+ */
+void PCSRGraph::spread(int firstLeaf, int leaves, const int* dests, const int* weights, int count) {
+    int size = 1 << segment_shift;
+    int at = 0;
+    for (int i = 0; i < leaves; ++i) {
+        int leaf = firstLeaf + i;
+        int take = count / leaves + (i < count % leaves);
+        int begin = leaf << segment_shift;
+        for (int k = 0; k < take; ++k) {
+            slot_dest[begin + k] = dests[at];
+            slot_weight[begin + k] = weights[at++];
+            if (isSentinel(slot_dest[begin + k])) starts[-2 - slot_dest[begin + k]] = begin + k;
+        }
+        for (int k = take; k < size; ++k) slot_dest[begin + k] = EMPTY;
+        leaf_used[leaf] = take;
+    }
+}
+
+/**
+ * @brief Replace the slot array with a new one holding the given elements.
+ * @param newCapacity Slots of the new array, a power of two.
+ */
+void PCSRGraph::layout(int newCapacity, const int* dests, const int* weights, int count) {
+    delete[] slot_dest;
+    delete[] slot_weight;
+    delete[] leaf_used;
+
+    capacity = newCapacity;
+    segment_shift = MIN_SEGMENT_SHIFT;
+    while ((1 << segment_shift) < log2Of(capacity)) ++segment_shift;
+    slot_dest = new int[capacity];
+    slot_weight = new int[capacity];
+    leaf_used = new int[leafCount()];
+    spread(0, leafCount(), dests, weights, count);
+}
+
+/**
+ * @brief Redistribute a window of leaves evenly.
+ * @param after Slot after which (dest, weight) is inserted, or -1 for none.
+ */
+void PCSRGraph::rebalance(int firstLeaf, int leaves, int after, int dest, int weight) {
+    int window = leaves << segment_shift;
+    int* dests = new int[window];
+    int* weights = new int[window];
+    int count = gather(firstLeaf, leaves, dests, weights, after, dest, weight);
+    spread(firstLeaf, leaves, dests, weights, count);
+    delete[] dests;
+    delete[] weights;
+}
+
+/**
+ * @brief Move every element into an array sized for the current count.
+ * @param after Slot after which (dest, weight) is inserted, or -1 for none.
+ */
+void PCSRGraph::resize(int after, int dest, int weight) {
+    int* dests = new int[capacity + 1];
+    int* weights = new int[capacity + 1];
+    int count = gather(0, leafCount(), dests, weights, after, dest, weight);
+    layout(capacityFor(count), dests, weights, count);
+    delete[] dests;
+    delete[] weights;
+}
+
+/**
+ * @brief Insert an element right after the element in slot after.
+ *
+ * Shifts the rest of the leaf if it has room; otherwise redistributes the
+ * smallest enclosing window that stays within its upper density bound, or
+ * grows the array if even the whole array would exceed its bound.
+ */
+void PCSRGraph::insertAfter(int after, int dest, int weight) {
+    int size = 1 << segment_shift;
+    int leaf = after >> segment_shift;
+    if (leaf_used[leaf] + 1 <= LEAF_UPPER * size) {
+        int end = (leaf << segment_shift) + leaf_used[leaf];
+        for (int slot = end; slot > after + 1; --slot) moveSlot(slot - 1, slot);
+        slot_dest[after + 1] = dest;
+        slot_weight[after + 1] = weight;
+        leaf_used[leaf]++;
+        return;
+    }
+
+    int height = log2Of(leafCount());
+    for (int level = 1; level <= height; ++level) {
+        int first = (leaf >> level) << level;
+        int count = 0;
+        for (int i = first; i < first + (1 << level); ++i) count += leaf_used[i];
+        if (count + 1 <= bound(LEAF_UPPER, ROOT_UPPER, level, height) * (size << level)) {
+            rebalance(first, 1 << level, after, dest, weight);
+            return;
+        }
+    }
+    resize(after, dest, weight);
+}
+
+/**
+ * @brief Remove the element in a slot.
+ *
+ * Closes the gap inside the leaf. Shrinks the array once the whole array
+ * drops below its lower density bound; otherwise, if the leaf drops below
+ * its bound, redistributes the smallest enclosing window that stays within
+ * its bound.
+ */
+void PCSRGraph::eraseAt(int slot) {
+    int size = 1 << segment_shift;
+    int leaf = slot >> segment_shift;
+    int end = (leaf << segment_shift) + leaf_used[leaf];
+    for (int i = slot; i + 1 < end; ++i) moveSlot(i + 1, i);
+    slot_dest[end - 1] = EMPTY;
+    leaf_used[leaf]--;
+    long long elements = num_of_vertices + arcs;
+    if (elements < ROOT_LOWER * capacity && capacityFor(elements) < capacity) {
+        resize(-1, 0, 0);     ///< Sentinels keep many leaves from ever emptying.
+        return;
+    }
+    if (leaf_used[leaf] >= LEAF_LOWER * size) return;
+
+    int height = log2Of(leafCount());
+    for (int level = 1; level <= height; ++level) {
+        int first = (leaf >> level) << level;
+        int count = 0;
+        for (int i = first; i < first + (1 << level); ++i) count += leaf_used[i];
+        if (count >= bound(LEAF_LOWER, ROOT_LOWER, level, height) * (size << level)) {
+            rebalance(first, 1 << level, -1, 0, 0);
+            return;
+        }
+    }
+    rebalance(0, leafCount(), -1, 0, 0);
+}
+
+/// Store one arc, after any parallel copies already in the row.
+void PCSRGraph::insertArc(int src, int dest, int weight) {
+    insertAfter(lastAtMost(src, dest), dest, weight);
+    degrees[src]++;
+    arcs++;
+}
+
+/// Remove the arc in a slot of src's row.
+void PCSRGraph::eraseArc(int src, int slot) {
+    degrees[src]--;
+    arcs--;
+    eraseAt(slot);
+}
+
+/**
+ * @brief Add a weighted edge (an arc src -> dest if directed).
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @param weight Weight of the edge.
+ */
+void PCSRGraph::addEdge(int src, int dest, int weight) {
+    if (!isValid(src, dest)) {
+        std::cout << "Invalid edge!" << std::endl;
+        return;
+    }
+    insertArc(src, dest, weight);
+    if (edge_direction == Direction::UNDIRECTED) insertArc(dest, src, weight);
+}
+
+/**
+ * @brief Remove an edge between two vertices (the arc src -> dest if directed).
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @throws std::runtime_error If the edge does not exist.
+ */
+void PCSRGraph::removeEdge(int src, int dest) {
+    if (!isValid(src, dest)) {
+        std::cout << "Invalid edge!" << std::endl;
+        return;
+    }
+    int slot = find(src, dest);
+    if (slot < 0) {
+        throw std::runtime_error("The edge does not exist and cannot be removed");
+    }
+    eraseArc(src, slot);
+    if (edge_direction == Direction::UNDIRECTED) eraseArc(dest, find(dest, src));
+}
+
+/**
+ * @brief Print the entire graph.
+ *
+ * Displays each vertex followed by its neighbors in ascending order.
+ */
+void PCSRGraph::print_graph() const {
+    OutputBuffer out(std::cout);
+    dump(*this, out);
+    out.flush();
+}
+
+/// @return Number of vertices in the graph.
+int PCSRGraph::getNumVertices() const {
+    return num_of_vertices;
+}
+
+/**
+ * @brief Get the number of neighbors for a given vertex.
+ * @param vertex Vertex index.
+ * @return Number of neighbors, or 0 if invalid vertex.
+ */
+int PCSRGraph::getNeighborCount(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return 0;
+    return degrees[vertex];
+}
+
+/**
+ * @brief Get all neighbors of a vertex in ascending order.
+ *
+ * Reads the row's slot range, jumping to the next leaf at the first gap.
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of neighbors, or nullptr if invalid.
+ * @note Caller is responsible for freeing the array.
+ */
+int* PCSRGraph::getNeighbors(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return nullptr;
+    int* neighbors = new int[degrees[vertex]];
+    int count = 0;
+    int end = rowEnd(vertex);
+    for (int slot = starts[vertex] + 1; slot < end;) {
+        if (slot_dest[slot] == EMPTY) {
+            slot = ((slot >> segment_shift) + 1) << segment_shift;
+            continue;
+        }
+        neighbors[count++] = slot_dest[slot++];
+    }
+    return neighbors;
+}
+
+/**
+ * @brief Get the weights of the edges of a vertex.
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of weights, parallel to getNeighbors(), or nullptr if invalid.
+ * @note Caller is responsible for freeing the array.
+ */
+int* PCSRGraph::getNeighborWeights(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return nullptr;
+    int* result = new int[degrees[vertex]];
+    int count = 0;
+    int end = rowEnd(vertex);
+    for (int slot = starts[vertex] + 1; slot < end;) {
+        if (slot_dest[slot] == EMPTY) {
+            slot = ((slot >> segment_shift) + 1) << segment_shift;
+            continue;
+        }
+        result[count++] = slot_weight[slot++];
+    }
+    return result;
+}
+
+/**
+ * @brief Get the weight of an edge between two vertices.
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @return Edge weight, or -1 if invalid or edge not found.
+ */
+int PCSRGraph::getEdgeWeight(int src, int dest) const {
+    if (!isValid(src, dest)) return -1;
+    int slot = find(src, dest);
+    return slot < 0 ? -1 : slot_weight[slot];
+}
+
+/**
+ * @brief Check if an edge exists between two vertices in O(log degree).
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @return True if the edge exists, false otherwise.
+ */
+bool PCSRGraph::containsEdge(int src, int dest) const {
+    return isValid(src, dest) && find(src, dest) >= 0;
+}
+
+/**
+ * @brief Count the total number of edges in the graph.
+ * @return Number of edges (arcs if directed).
+ */
+long long PCSRGraph::countEdges() const {
+    if (edge_direction == Direction::DIRECTED) return arcs;
+    return arcs / 2; ///< Divide by 2 since the graph is undirected.
+}
+
+} // namespace graph
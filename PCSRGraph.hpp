@@ -0,0 +1,89 @@
+// ronavraham99@gmail.com
+
+#ifndef PCSR_GRAPH_HPP
+#define PCSR_GRAPH_HPP
+
+#include "Graph.hpp"
+
+namespace graph {
+
+/**
+ * @class PCSRGraph
+ * @brief Dynamic CSR graph stored in a packed memory array (PCSR).
+ *
+ * All edges live in one slot array, sorted by (source, destination), with
+ * gaps left between them so an insertion only shifts a few neighbors.
+ * Each vertex's row starts with a sentinel slot and is followed by its
+ * edges, so a neighbor scan reads one contiguous range like CSR does.
+ *
+ * The array is cut into leaf segments of about log2(capacity) slots whose
+ * elements are packed at the leaf's start. An insertion into a full leaf
+ * (or a deletion that empties one) redistributes the smallest enclosing
+ * power-of-two window of leaves whose density is within bounds; the
+ * bounds tighten towards the root, and the array doubles or halves when
+ * the root itself is out of bounds. Updates cost amortized O(log^2 n)
+ * element moves plus an O(log degree) search of the row.
+ *
+ * Rows are kept sorted by destination, so getNeighbors() lists neighbors
+ * in ascending order. Parallel edges and self-loops are kept as in Graph.
+ * Offers the same query API as Graph, so Algorithms run on it directly.
+ */
+class PCSRGraph {
+public:
+    typedef int vertex_type;  ///< Vertex ID type.
+    typedef int weight_type;  ///< Weight type.
+
+private:
+    int num_of_vertices;      ///< Number of vertices in the graph.
+    Direction edge_direction; ///< Whether edges are mirrored.
+    int capacity;             ///< Slots in the array, a power of two.
+    int segment_shift;        ///< log2 of the leaf segment size.
+    int* slot_dest;           ///< Destination per slot, EMPTY for a gap, or a row sentinel.
+    int* slot_weight;         ///< Weight per slot, parallel to slot_dest.
+    int* leaf_used;           ///< Elements in each leaf, packed at the leaf's start.
+    int* starts;              ///< Slot of each vertex's sentinel.
+    int* degrees;             ///< Number of stored arcs per vertex.
+    long long arcs;           ///< Stored arcs (twice the edges if undirected).
+
+    void init(int vertices, Direction direction);
+    bool isValid(int src, int dest) const;
+    int leafCount() const {return capacity >> segment_shift;}
+    int rowEnd(int vertex) const;
+    int lastAtMost(int vertex, int dest) const;
+    int find(int src, int dest) const;
+    void moveSlot(int from, int to);
+    int gather(int firstLeaf, int leaves, int* dests, int* weights,
+               int after, int dest, int weight) const;
+    void spread(int firstLeaf, int leaves, const int* dests, const int* weights, int count);
+    void layout(int newCapacity, const int* dests, const int* weights, int count);
+    void rebalance(int firstLeaf, int leaves, int after, int dest, int weight);
+    void resize(int after, int dest, int weight);
+    void insertAfter(int after, int dest, int weight);
+    void eraseAt(int slot);
+    void insertArc(int src, int dest, int weight);
+    void eraseArc(int src, int slot);
+
+public:
+    PCSRGraph(int vertices, Direction direction = Direction::UNDIRECTED);
+    PCSRGraph(const Graph& g);
+    ~PCSRGraph();
+    PCSRGraph(const PCSRGraph&) = delete;
+    PCSRGraph& operator=(const PCSRGraph&) = delete;
+
+    void addEdge(int src, int dest, int weight = 1);
+    void removeEdge(int src, int dest);
+    void print_graph() const;
+    int getNumVertices() const;
+    int getNeighborCount(int vertex) const;
+    int* getNeighbors(int vertex) const;
+    int* getNeighborWeights(int vertex) const;
+    int getEdgeWeight(int src, int dest) const;
+    bool containsEdge(int src, int dest) const;
+    long long countEdges() const;
+    Direction direction() const {return edge_direction;}
+    int slotCount() const {return capacity;}
+};
+
+} // namespace graph
+
+#endif // PCSR_GRAPH_HPP
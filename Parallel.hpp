@@ -0,0 +1,41 @@
+// ronavraham99@gmail.com
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <thread>
+
+namespace graph {
+
+/**
+ * @brief Resolve a requested thread count.
+ * @param threads Requested threads, 0 for one per hardware thread.
+ * @param work Number of independent work items; no more threads than this are used.
+ * @return A thread count between 1 and max(work, 1).
+ */
+inline unsigned workerCount(unsigned threads, long long work) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    if (static_cast<long long>(threads) > work) threads = work > 0 ? static_cast<unsigned>(work) : 1;
+    return threads;
+}
+
+/**
+ * @brief Run body(t, begin, end) for t in [0, threads) over equal slices of [0, total).
+ *
+ * Slice 0 runs on the calling thread; with one thread nothing is spawned.
+ */
+template <typename Body>
+void forEachSlice(unsigned threads, long long total, Body body) {
+    std::thread* workers = new std::thread[threads - 1];
+    for (unsigned t = 1; t < threads; ++t) {
+        workers[t - 1] = std::thread(body, t, total * t / threads, total * (t + 1) / threads);
+    }
+    body(0u, 0LL, total / threads);
+    for (unsigned t = 1; t < threads; ++t) workers[t - 1].join();
+    delete[] workers;
+}
+
+} // namespace graph
+
+#endif // PARALLEL_HPP
@@ -0,0 +1,202 @@
+// ronavraham99@gmail.com
+
+#include "SimdSearch.hpp"
+#include <atomic>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define GRAPH_SIMD_X86 1
+#endif
+
+namespace graph {
+
+/**
+ * @brief Portable search, newest (highest) slot first.
+ */
+template <typename T>
+static int findSlotScalar(const T* values, int count, T key) {
+    for (int i = count - 1; i >= 0; --i) {
+        if (values[i] == key) return i;
+    }
+    return -1;
+}
+
+#ifdef GRAPH_SIMD_X86
+
+/// Index of the highest set bit of a non-zero mask.
+static inline int highestBit(unsigned int mask) {
+    return 31 - __builtin_clz(mask);
+}
+
+/**
+ * @brief SSE2 search, 4 values per compare.
+ *
+ * Walks 4-wide chunks from the top of the array down. A remainder shorter
+ * than a chunk is covered by one overlapping load at slot 0 whose lanes
+ * above the remainder are masked off, so nothing is read past `count`.
+ */
+static int findSlotSse2(const int* values, int count, int key) {
+    if (count < 4) return findSlotScalar(values, count, key);
+
+    __m128i needle = _mm_set1_epi32(key);
+    int i = count;
+    while (i >= 4) {
+        i -= 4;
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        unsigned int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(chunk, needle)));
+        if (mask != 0) return i + highestBit(mask);
+    }
+    if (i > 0) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+        unsigned int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(chunk, needle)));
+        mask &= (1u << i) - 1;
+        if (mask != 0) return highestBit(mask);
+    }
+    return -1;
+}
+
+/**
+ * @brief AVX2 search, 8 values per compare.
+ *
+ * Same chunking as findSlotSse2; short arrays fall back to it.
+ */
+__attribute__((target("avx2")))
+static int findSlotAvx2(const int* values, int count, int key) {
+    if (count < 8) return findSlotSse2(values, count, key);
+
+    __m256i needle = _mm256_set1_epi32(key);
+    int i = count;
+    while (i >= 8) {
+        i -= 8;
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        unsigned int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(chunk, needle)));
+        if (mask != 0) return i + highestBit(mask);
+    }
+    if (i > 0) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+        unsigned int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(chunk, needle)));
+        mask &= (1u << i) - 1;
+        if (mask != 0) return highestBit(mask);
+    }
+    return -1;
+}
+
+/**
+ * @brief SSE4.1 search over 64-bit values, 2 per compare.
+ */
+__attribute__((target("sse4.1")))
+static int findSlotSse41(const long long* values, int count, long long key) {
+    if (count < 2) return findSlotScalar(values, count, key);
+
+    __m128i needle = _mm_set1_epi64x(key);
+    int i = count;
+    while (i >= 2) {
+        i -= 2;
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        unsigned int mask = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(chunk, needle)));
+        if (mask != 0) return i + highestBit(mask);
+    }
+    if (i > 0 && values[0] == key) return 0;
+    return -1;
+}
+
+/**
+ * @brief AVX2 search over 64-bit values, 4 per compare.
+ */
+__attribute__((target("avx2")))
+static int findSlotAvx2(const long long* values, int count, long long key) {
+    if (count < 4) return findSlotSse41(values, count, key);
+
+    __m256i needle = _mm256_set1_epi64x(key);
+    int i = count;
+    while (i >= 4) {
+        i -= 4;
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        unsigned int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(chunk, needle)));
+        if (mask != 0) return i + highestBit(mask);
+    }
+    if (i > 0) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+        unsigned int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(chunk, needle)));
+        mask &= (1u << i) - 1;
+        if (mask != 0) return highestBit(mask);
+    }
+    return -1;
+}
+
+#endif // GRAPH_SIMD_X86
+
+typedef int (*FindSlotKernel)(const int*, int, int);
+typedef int (*FindSlotKernel64)(const long long*, int, long long);
+
+/**
+ * @brief Pick the widest kernel the running CPU supports.
+ */
+static FindSlotKernel selectKernel(const char** name) {
+#ifdef GRAPH_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        *name = "avx2";
+        return findSlotAvx2;
+    }
+    *name = "sse2";    ///< Always available on x86-64.
+    return findSlotSse2;
+#else
+    *name = "scalar";
+    return findSlotScalar<int>;
+#endif
+}
+
+/**
+ * @brief Pick the widest 64-bit kernel the running CPU supports.
+ */
+static FindSlotKernel64 selectKernel64() {
+#ifdef GRAPH_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return findSlotAvx2;
+    if (__builtin_cpu_supports("sse4.1")) return findSlotSse41;
+#endif
+    return findSlotScalar<long long>;
+}
+
+static int resolveFindSlot(const int* values, int count, int key);
+static int resolveFindSlot64(const long long* values, int count, long long key);
+
+/**
+ * Kernels in use, starting at the resolvers. Both are constant-initialized,
+ * so findSlot works even when called from another translation unit's
+ * static initializers; the first call installs the selected kernel.
+ */
+static std::atomic<FindSlotKernel> kernel(resolveFindSlot);
+static std::atomic<FindSlotKernel64> kernel64(resolveFindSlot64);
+
+/// First call of the 32-bit findSlot: select the kernel, install it and run it.
+static int resolveFindSlot(const int* values, int count, int key) {
+    const char* name;
+    FindSlotKernel chosen = selectKernel(&name);
+    kernel.store(chosen, std::memory_order_relaxed);
+    return chosen(values, count, key);
+}
+
+/// First call of the 64-bit findSlot: select the kernel, install it and run it.
+static int resolveFindSlot64(const long long* values, int count, long long key) {
+    FindSlotKernel64 chosen = selectKernel64();
+    kernel64.store(chosen, std::memory_order_relaxed);
+    return chosen(values, count, key);
+}
+
+int findSlot(const int* values, int count, int key) {
+    return kernel.load(std::memory_order_relaxed)(values, count, key);
+}
+
+int findSlot(const long long* values, int count, long long key) {
+    return kernel64.load(std::memory_order_relaxed)(values, count, key);
+}
+
+const char* simdLevel() {
+    const char* name;
+    selectKernel(&name);
+    return name;
+}
+
+} // namespace graph
@@ -0,0 +1,35 @@
+// ronavraham99@gmail.com
+
+#ifndef SIMD_SEARCH_HPP
+#define SIMD_SEARCH_HPP
+
+namespace graph {
+
+/**
+ * @brief Find the highest slot of an array holding a given value.
+ *
+ * Compares several values per instruction (AVX2 or SSE2) when the CPU
+ * supports it, with a scalar fallback. The kernel is chosen from CPU
+ * feature detection on the first call, so it is safe to call during
+ * static initialization.
+ * @param values Array to search.
+ * @param count Number of values in the array.
+ * @param key Value to search for.
+ * @return Index of the last matching slot, or -1 if not found.
+ */
+int findSlot(const int* values, int count, int key);
+
+/**
+ * @brief 64-bit variant of findSlot (AVX2 or SSE4.1, scalar fallback).
+ */
+int findSlot(const long long* values, int count, long long key);
+
+/**
+ * @brief Name of the kernel selected by the 32-bit findSlot.
+ * @return "avx2", "sse2" or "scalar".
+ */
+const char* simdLevel();
+
+} // namespace graph
+
+#endif // SIMD_SEARCH_HPP
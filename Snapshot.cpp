@@ -0,0 +1,402 @@
+// ronavraham99@gmail.com
+
+#include "Snapshot.hpp"
+#include "Dump.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace graph {
+
+static const char SNAPSHOT_MAGIC[8] = {'G', 'R', 'A', 'P', 'H', 'S', 'N', 'P'};
+static const uint32_t FLAG_DIRECTED = 1;
+
+/**
+ * @brief Running 64-bit checksum over a byte stream.
+ *
+ * FNV-1a style, but mixing 8 bytes per step so it keeps up with disk and
+ * memory bandwidth. Chunks may have any length; the result depends only on
+ * the concatenated bytes.
+ */
+struct Checksum {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    unsigned char pending[8];   ///< Bytes not yet forming a full word.
+    int pendingCount = 0;
+
+    void mix(uint64_t word) {
+        hash = (hash ^ word) * 0x100000001b3ULL;
+        hash ^= hash >> 29;
+    }
+
+    void update(const void* data, long long size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        while (size > 0 && pendingCount > 0) {
+            pending[pendingCount++] = *bytes++;
+            --size;
+            if (pendingCount == 8) {
+                uint64_t word;
+                std::memcpy(&word, pending, 8);
+                mix(word);
+                pendingCount = 0;
+            }
+        }
+        for (; size >= 8; size -= 8, bytes += 8) {
+            uint64_t word;
+            std::memcpy(&word, bytes, 8);
+            mix(word);
+        }
+        while (size-- > 0) pending[pendingCount++] = *bytes++;
+    }
+
+    uint64_t finish() {
+        uint64_t word = 0;
+        std::memcpy(&word, pending, pendingCount);
+        mix(word ^ (static_cast<uint64_t>(pendingCount) << 56));
+        return hash;
+    }
+};
+
+/// Checksum of one contiguous buffer.
+static uint64_t checksumOf(const void* data, long long size) {
+    Checksum sum;
+    sum.update(data, size);
+    return sum.finish();
+}
+
+/// Size of a section rounded up to the 8-byte section alignment.
+static long long padded(long long bytes) {
+    return (bytes + 7) & ~7LL;
+}
+
+/// Write a buffer, throwing on a short write.
+static void writeAll(std::FILE* file, const void* data, long long size) {
+    if (size > 0 && std::fwrite(data, 1, size, file) != static_cast<size_t>(size)) {
+        throw std::runtime_error("Failed to write snapshot");
+    }
+}
+
+/**
+ * @brief Sort one row by destination, keeping weights aligned.
+ */
+static void sortRow(int* neighbors, int* weights, int count) {
+    struct Arc {
+        int dest, weight;
+    };
+    Arc* arcs = new Arc[count];
+    for (int i = 0; i < count; ++i) arcs[i] = {neighbors[i], weights[i]};
+    std::sort(arcs, arcs + count, [](const Arc& a, const Arc& b) {
+        return a.dest < b.dest || (a.dest == b.dest && a.weight < b.weight);
+    });
+    for (int i = 0; i < count; ++i) {
+        neighbors[i] = arcs[i].dest;
+        weights[i] = arcs[i].weight;
+    }
+    delete[] arcs;
+}
+
+/**
+ * @brief Write a graph as a binary snapshot.
+ *
+ * Sections are streamed one row at a time, so no CSR copy of the graph is
+ * built in memory. The header, which carries the checksums, is rewritten
+ * once all sections are out.
+ * @param g Graph to save.
+ * @param path Output file, replaced if it exists.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+void writeSnapshot(const Graph& g, const char* path) {
+    std::FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) throw std::runtime_error("Cannot open snapshot file for writing");
+
+    int n = g.getNumVertices();
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.flags = g.isDirected() ? FLAG_DIRECTED : 0;
+    header.vertices = n;
+    static const unsigned char zeros[8] = {0};
+
+    try {
+        writeAll(file, &header, sizeof(header));     ///< Placeholder, rewritten below.
+
+        Checksum offsetSum;
+        long long offset = 0;
+        for (int v = 0; v <= n; ++v) {
+            writeAll(file, &offset, sizeof(offset));
+            offsetSum.update(&offset, sizeof(offset));
+            if (v < n) offset += g.getNeighborCount(v);
+        }
+        header.arcs = offset;
+        header.offsets_checksum = offsetSum.finish();
+
+        Checksum destSum, weightSum;
+        for (int pass = 0; pass < 2; ++pass) {       ///< Destinations, then weights.
+            Checksum& sum = pass == 0 ? destSum : weightSum;
+            for (int v = 0; v < n; ++v) {
+                int count = g.getNeighborCount(v);
+                int* neighbors = g.getNeighbors(v);
+                int* weights = g.getNeighborWeights(v);
+                sortRow(neighbors, weights, count);
+                const int* row = pass == 0 ? neighbors : weights;
+                writeAll(file, row, count * static_cast<long long>(sizeof(int)));
+                sum.update(row, count * static_cast<long long>(sizeof(int)));
+                delete[] neighbors;
+                delete[] weights;
+            }
+            long long bytes = offset * static_cast<long long>(sizeof(int));
+            writeAll(file, zeros, padded(bytes) - bytes);
+        }
+        header.dest_checksum = destSum.finish();
+        header.weight_checksum = weightSum.finish();
+        header.header_checksum = checksumOf(&header, offsetof(SnapshotHeader, header_checksum));
+
+        if (std::fseek(file, 0, SEEK_SET) != 0) throw std::runtime_error("Failed to write snapshot");
+        writeAll(file, &header, sizeof(header));
+    } catch (...) {
+        std::fclose(file);
+        throw;
+    }
+    if (std::fclose(file) != 0) throw std::runtime_error("Failed to write snapshot");
+}
+
+/// Reverse the bytes of a 32-bit value.
+static uint32_t byteSwap(uint32_t value) {
+    return (value >> 24) | ((value >> 8) & 0xff00) | ((value << 8) & 0xff0000) | (value << 24);
+}
+
+/**
+ * @brief Map a snapshot file and validate its header.
+ *
+ * Opening touches only the header and the first and last offsets, so the
+ * graph is usable right away. Every offset and destination is checked only
+ * if checkStructure is set, or later by verify(); without either, a
+ * corrupt file can send a query outside the mapping.
+ * @param path Snapshot written by writeSnapshot().
+ * @param checkStructure Also scan the offsets and destinations (O(V + E)).
+ * @throws std::runtime_error If the file cannot be mapped, is not a
+ *         snapshot of this version and byte order, is shorter than its
+ *         header claims, or has offsets (or, when checked, destinations)
+ *         out of range.
+ */
+SnapshotGraph::SnapshotGraph(const char* path, bool checkStructure) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Cannot open snapshot file");
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(SnapshotHeader))) {
+        ::close(fd);
+        throw std::runtime_error("Not a graph snapshot");
+    }
+    mapped_bytes = info.st_size;
+    mapping = ::mmap(nullptr, mapped_bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);    ///< The mapping stays valid after the descriptor is closed.
+    if (mapping == MAP_FAILED) throw std::runtime_error("Cannot map snapshot file");
+
+    const SnapshotHeader* header = static_cast<const SnapshotHeader*>(mapping);
+    const char* error = nullptr;
+    if (std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0) {
+        error = "Not a graph snapshot";
+    } else if (header->version != SNAPSHOT_VERSION && byteSwap(header->version) == SNAPSHOT_VERSION) {
+        error = "Snapshot written with the other byte order";
+    } else if (header->version != SNAPSHOT_VERSION) {
+        error = "Unsupported snapshot version";
+    } else if (header->header_checksum !=
+               checksumOf(header, offsetof(SnapshotHeader, header_checksum))) {
+        error = "Corrupt snapshot header";
+    } else if (header->vertices > 0x7fffffffULL || header->arcs > (1ULL << 60)) {
+        error = "Corrupt snapshot header";
+    } else {
+        long long arcBytes = padded(header->arcs * static_cast<long long>(sizeof(int)));
+        long long expected = sizeof(SnapshotHeader) +
+                             (header->vertices + 1) * static_cast<long long>(sizeof(long long)) +
+                             2 * arcBytes;
+        if (mapped_bytes < expected) error = "Truncated snapshot";
+    }
+    if (error == nullptr) {
+        num_of_vertices = static_cast<int>(header->vertices);
+        arcs = header->arcs;
+        edge_direction = (header->flags & FLAG_DIRECTED) ? Direction::DIRECTED : Direction::UNDIRECTED;
+        const char* base = static_cast<const char*>(mapping);
+        offsets = reinterpret_cast<const long long*>(base + sizeof(SnapshotHeader));
+        dests = reinterpret_cast<const int*>(offsets + num_of_vertices + 1);
+        weights = reinterpret_cast<const int*>(reinterpret_cast<const char*>(dests) +
+                                               padded(arcs * static_cast<long long>(sizeof(int))));
+        if (offsets[0] != 0 || offsets[num_of_vertices] != arcs) {
+            error = "Corrupt snapshot";
+        } else if (checkStructure && !wellFormed()) {
+            error = "Corrupt snapshot";
+        }
+    }
+    if (error != nullptr) {
+        ::munmap(mapping, mapped_bytes);
+        throw std::runtime_error(error);
+    }
+}
+
+/**
+ * @brief Check that the rows tile the destinations and point at real vertices.
+ * @return True if offsets never decrease and keep each row within int
+ *         range, and every destination is a vertex.
+ */
+bool SnapshotGraph::wellFormed() const {
+    for (int v = 0; v < num_of_vertices; ++v) {
+        long long count = offsets[v + 1] - offsets[v];
+        if (count < 0 || count > 0x7fffffffLL) return false;
+    }
+    for (long long i = 0; i < arcs; ++i) {
+        if (dests[i] < 0 || dests[i] >= num_of_vertices) return false;
+    }
+    return true;
+}
+
+/// Destructor – unmaps the file.
+SnapshotGraph::~SnapshotGraph() {
+    ::munmap(mapping, mapped_bytes);
+}
+
+/**
+ * @brief Check the structure and every section against the checksums in the header.
+ *
+ * Reads the whole file once.
+ * @return True if all offsets and destinations are in range and all
+ *         sections are intact.
+ */
+bool SnapshotGraph::verify() const {
+    const SnapshotHeader* header = static_cast<const SnapshotHeader*>(mapping);
+    long long arcBytes = arcs * static_cast<long long>(sizeof(int));
+    return wellFormed() &&
+           checksumOf(offsets, (num_of_vertices + 1) * static_cast<long long>(sizeof(long long))) ==
+               header->offsets_checksum &&
+           checksumOf(dests, arcBytes) == header->dest_checksum &&
+           checksumOf(weights, arcBytes) == header->weight_checksum;
+}
+
+/// @return True if both endpoints are valid vertices.
+bool SnapshotGraph::isValid(int src, int dest) const {
+    return src >= 0 && dest >= 0 && src < num_of_vertices && dest < num_of_vertices;
+}
+
+/**
+ * @brief Binary search for an arc in a sorted row.
+ * @return Index of the arc in dests, or -1 if absent.
+ */
+long long SnapshotGraph::position(int src, int dest) const {
+    const int* begin = dests + offsets[src];
+    const int* end = dests + offsets[src + 1];
+    const int* found = std::lower_bound(begin, end, dest);
+    return (found != end && *found == dest) ? found - dests : -1;
+}
+
+/**
+ * @brief Zero-copy access to a vertex's neighbors.
+ * @param vertex Vertex index.
+ * @return Pointer into the mapping (getNeighborCount entries, ascending), or nullptr if invalid.
+ */
+const int* SnapshotGraph::neighborsOf(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return nullptr;
+    return dests + offsets[vertex];
+}
+
+/**
+ * @brief Zero-copy access to a vertex's edge weights, parallel to neighborsOf().
+ * @param vertex Vertex index.
+ * @return Pointer into the mapping, or nullptr if invalid.
+ */
+const int* SnapshotGraph::weightsOf(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return nullptr;
+    return weights + offsets[vertex];
+}
+
+/**
+ * @brief Print the entire graph.
+ *
+ * Displays each vertex followed by its neighbors in ascending order.
+ */
+void SnapshotGraph::print_graph() const {
+    OutputBuffer out(std::cout);
+    dump(*this, out);
+    out.flush();
+}
+
+/// @return Number of vertices in the graph.
+int SnapshotGraph::getNumVertices() const {
+    return num_of_vertices;
+}
+
+/**
+ * @brief Get the number of neighbors for a given vertex.
+ * @param vertex Vertex index.
+ * @return Number of neighbors, or 0 if invalid vertex.
+ */
+int SnapshotGraph::getNeighborCount(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return 0;
+    return static_cast<int>(offsets[vertex + 1] - offsets[vertex]);
+}
+
+/**
+ * @brief Get all neighbors of a vertex.
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of neighbors in ascending order, or nullptr if invalid.
+ * @note Caller is responsible for freeing the array; neighborsOf() avoids the copy.
+ */
+int* SnapshotGraph::getNeighbors(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return nullptr;
+    int count = getNeighborCount(vertex);
+    int* neighbors = new int[count];
+    std::memcpy(neighbors, dests + offsets[vertex], count * sizeof(int));
+    return neighbors;
+}
+
+/**
+ * @brief Get the weights of all edges leaving a vertex.
+ * @param vertex Vertex index.
+ * @return Dynamically allocated array of weights, parallel to getNeighbors(), or nullptr if invalid.
+ * @note Caller is responsible for freeing the array; weightsOf() avoids the copy.
+ */
+int* SnapshotGraph::getNeighborWeights(int vertex) const {
+    if (vertex < 0 || vertex >= num_of_vertices) return nullptr;
+    int count = getNeighborCount(vertex);
+    int* result = new int[count];
+    std::memcpy(result, weights + offsets[vertex], count * sizeof(int));
+    return result;
+}
+
+/**
+ * @brief Get the weight of an edge between two vertices.
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @return Edge weight, or -1 if invalid or edge not found.
+ */
+int SnapshotGraph::getEdgeWeight(int src, int dest) const {
+    if (!isValid(src, dest)) return -1;
+    long long at = position(src, dest);
+    return at < 0 ? -1 : weights[at];
+}
+
+/**
+ * @brief Check if an edge exists between two vertices, by binary search.
+ * @param src Source vertex.
+ * @param dest Destination vertex.
+ * @return True if the edge exists, false otherwise.
+ */
+bool SnapshotGraph::containsEdge(int src, int dest) const {
+    return isValid(src, dest) && position(src, dest) >= 0;
+}
+
+/**
+ * @brief Count the total number of edges in the graph.
+ * @return Number of undirected edges, or of arcs if the graph is directed.
+ */
+long long SnapshotGraph::countEdges() const {
+    if (edge_direction == Direction::DIRECTED) return arcs;
+    return arcs / 2; ///< Divide by 2 since the graph is undirected.
+}
+
+} // namespace graph
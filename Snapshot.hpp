@@ -0,0 +1,93 @@
+// ronavraham99@gmail.com
+
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include "Graph.hpp"
+
+namespace graph {
+
+/**
+ * @struct SnapshotHeader
+ * @brief Fixed 64-byte header of a binary graph snapshot.
+ *
+ * The header is followed by three sections, each starting on an 8-byte
+ * boundary: offsets (vertices + 1 int64 values), destinations (arcs int32
+ * values) and weights (arcs int32 values). Every vertex's neighbors are
+ * sorted in ascending order. Values are stored in the writing host's byte
+ * order (little-endian on x86 and ARM) so they can be used in place; a
+ * snapshot opened on a host of the other byte order is rejected.
+ */
+struct SnapshotHeader {
+    char magic[8];                  ///< "GRAPHSNP".
+    uint32_t version;               ///< Format version, SNAPSHOT_VERSION.
+    uint32_t flags;                 ///< Bit 0: directed.
+    uint64_t vertices;              ///< Number of vertices.
+    uint64_t arcs;                  ///< Stored adjacency entries (2 per undirected edge).
+    uint64_t offsets_checksum;      ///< Checksum of the offsets section.
+    uint64_t dest_checksum;         ///< Checksum of the destinations section.
+    uint64_t weight_checksum;       ///< Checksum of the weights section.
+    uint64_t header_checksum;       ///< Checksum of the header fields above.
+};
+
+/// Current snapshot format version.
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+void writeSnapshot(const Graph& g, const char* path);
+
+/**
+ * @class SnapshotGraph
+ * @brief Read-only CSR view of a snapshot file, mapped with mmap.
+ *
+ * Opening validates the header only, so the graph is usable right away
+ * without parsing or copying; pages are loaded by the OS on first touch.
+ * A file that may be corrupt should be opened with checkStructure, or
+ * checked with verify(), before it is queried: both read every offset and
+ * destination, and verify() also checks the section checksums.
+ * neighborsOf()/weightsOf() expose rows without copying.
+ *
+ * Offers the same query API as Graph, so Algorithms run on it directly.
+ */
+class SnapshotGraph {
+public:
+    typedef int vertex_type;  ///< Vertex ID type.
+    typedef int weight_type;  ///< Weight type.
+
+private:
+    void* mapping;            ///< Start of the mapped file.
+    long long mapped_bytes;   ///< Length of the mapping.
+    int num_of_vertices;      ///< Number of vertices in the graph.
+    long long arcs;           ///< Stored adjacency entries.
+    Direction edge_direction; ///< Direction of the source graph.
+    const long long* offsets; ///< Row starts, num_of_vertices + 1 entries.
+    const int* dests;         ///< Destinations, sorted per row.
+    const int* weights;       ///< Weights, parallel to dests.
+
+    bool isValid(int src, int dest) const;
+    bool wellFormed() const;
+    long long position(int src, int dest) const;
+
+public:
+    SnapshotGraph(const char* path, bool checkStructure = false);
+    ~SnapshotGraph();
+    SnapshotGraph(const SnapshotGraph&) = delete;
+    SnapshotGraph& operator=(const SnapshotGraph&) = delete;
+
+    bool verify() const;
+    const int* neighborsOf(int vertex) const;
+    const int* weightsOf(int vertex) const;
+
+    void print_graph() const;
+    int getNumVertices() const;
+    int getNeighborCount(int vertex) const;
+    int* getNeighbors(int vertex) const;
+    int* getNeighborWeights(int vertex) const;
+    int getEdgeWeight(int src, int dest) const;
+    bool containsEdge(int src, int dest) const;
+    long long countEdges() const;
+    Direction direction() const {return edge_direction;}
+};
+
+} // namespace graph
+
+#endif // SNAPSHOT_HPP
@@ -2,11 +2,45 @@
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include "Graph.hpp"
 #include "Algorithms.hpp"
+#include "SimdSearch.hpp"
+#include "CompressedGraph.hpp"
+#include "ConcurrentGraph.hpp"
+#include "DeltaGraph.hpp"
+#include "DenseGraph.hpp"
+#include "EdgeTableGraph.hpp"
+#include "PCSRGraph.hpp"
+#include "Snapshot.hpp"
+#include "GraphIO.hpp"
+#include "Dump.hpp"
+#include "EdgeIngestor.hpp"
+#include "WorkPool.hpp"
+#include <fcntl.h>
+#include <unistd.h>
 
 using namespace graph;
 
+/// Sum of the weights of all edges of a graph.
+static long long totalWeight(const Graph& g) {
+    long long total = 0;
+    for (int u = 0; u < g.getNumVertices(); ++u) {
+        int count = g.getNeighborCount(u);
+        int* weights = g.getNeighborWeights(u);
+        for (int i = 0; i < count; ++i) total += weights[i];
+        delete[] weights;
+    }
+    return total / 2;
+}
+
 // ----------- BFS TESTS -----------
 
 
@@ -208,3 +242,2185 @@ TEST_CASE("Kruskal's Minimum Spanning Tree") {
         CHECK(mst.getNumVertices() == 0);
     }
 }
+
+// ----------- ADJACENCY INDEX TESTS -----------
+
+/**
+ * Test the hash index attached to high-degree adjacency lists.
+ */
+TEST_CASE("Hash index on hub vertices") {
+    const int n = 3 * AdjacencyList::HASH_INDEX_THRESHOLD;
+
+    SUBCASE("Lookups on an indexed hub") {
+        AdjacencyList list;
+        for (int v = 0; v < n; ++v) list.addEdge(v, v + 100);
+
+        CHECK(list.isIndexed());
+        CHECK(list.count() == n);
+        CHECK(list.contains(0));
+        CHECK(list.contains(n - 1));
+        CHECK_FALSE(list.contains(n));
+        CHECK(list.getWeight(7) == 107);
+        CHECK(list.getWeight(n + 5) == -1);
+    }
+
+    SUBCASE("Removal keeps list and index consistent") {
+        AdjacencyList list;
+        for (int v = 0; v < n; ++v) list.addEdge(v, v);
+
+        for (int v = 0; v < n; v += 2) list.removeEdge(v);
+
+        CHECK(list.count() == n / 2);
+        for (int v = 0; v < n; ++v) {
+            CHECK(list.contains(v) == (v % 2 == 1));
+            if (v % 2 == 1) CHECK(list.getWeight(v) == v);
+        }
+        CHECK_THROWS(list.removeEdge(0));
+
+        int* neighbors = list.getAllNeighbors();
+        int sum = 0;
+        for (int i = 0; i < list.count(); ++i) sum += neighbors[i];
+        delete[] neighbors;
+        CHECK(sum == (n / 2) * (n / 2));  ///< Sum of the odd numbers below n.
+    }
+
+    SUBCASE("Parallel edges and index release") {
+        AdjacencyList list;
+        for (int v = 0; v < n; ++v) list.addEdge(v, 1);
+        list.addEdge(5, 2);
+        list.addEdge(5, 3);
+
+        list.removeEdge(5);
+        CHECK(list.contains(5));
+        list.removeEdge(5);
+        CHECK(list.contains(5));
+        list.removeEdge(5);
+        CHECK_FALSE(list.contains(5));
+
+        for (int v = 0; v < n; ++v) {
+            if (v != 5) list.removeEdge(v);
+        }
+        CHECK_FALSE(list.isIndexed());
+        CHECK(list.count() == 0);
+    }
+
+    SUBCASE("Star graph through the Graph API") {
+        Graph g(n + 1);
+        for (int v = 1; v <= n; ++v) g.addEdge(0, v, v);
+
+        CHECK(g.getNeighborCount(0) == n);
+        CHECK(g.containsEdge(0, n));
+        CHECK(g.getEdgeWeight(0, 10) == 10);
+        g.removeEdge(0, 10);
+        CHECK_FALSE(g.containsEdge(0, 10));
+        CHECK_FALSE(g.containsEdge(10, 0));
+        CHECK(g.countEdges() == n - 1);
+    }
+}
+
+/**
+ * Test the unrolled block layout of adjacency lists.
+ */
+TEST_CASE("Unrolled adjacency blocks") {
+    CHECK(sizeof(Block) == 128);
+    CHECK(alignof(Block) == 64);
+
+    SUBCASE("Blocks fill before a new one is started") {
+        AdjacencyList list;
+        for (int v = 0; v < Block::CAPACITY; ++v) list.addEdge(v, v);
+        CHECK(list.getHead()->next == nullptr);
+        CHECK(list.getHead()->used == Block::CAPACITY);
+
+        list.addEdge(Block::CAPACITY, 0);
+        CHECK(list.getHead()->used == 1);
+        CHECK(list.getHead()->next != nullptr);
+    }
+
+    SUBCASE("Neighbors are listed newest first") {
+        AdjacencyList list;
+        for (int v = 0; v < 20; ++v) list.addEdge(v, 2 * v);
+
+        int* neighbors = list.getAllNeighbors();
+        for (int i = 0; i < 20; ++i) CHECK(neighbors[i] == 19 - i);
+        delete[] neighbors;
+    }
+
+    SUBCASE("Removal from a full block refills it from the head block") {
+        AdjacencyList list;
+        for (int v = 0; v < 20; ++v) list.addEdge(v, 2 * v);
+
+        list.removeEdge(0);
+        list.removeEdge(13);
+        CHECK(list.count() == 18);
+        CHECK(list.getHead()->used == 4);
+        for (int v = 1; v < 20; ++v) {
+            if (v == 13) continue;
+            CHECK(list.contains(v));
+            CHECK(list.getWeight(v) == 2 * v);
+        }
+
+        for (int v = 14; v < 20; ++v) list.removeEdge(v);
+        CHECK(list.getHead()->next == nullptr);
+        CHECK(list.count() == 12);
+    }
+}
+
+/**
+ * Test the SIMD slot search against a plain scan.
+ */
+TEST_CASE("SIMD neighbor search") {
+    CHECK((std::string(simdLevel()) == "avx2" || std::string(simdLevel()) == "sse2" ||
+           std::string(simdLevel()) == "scalar"));
+
+    int values[40];
+    for (int count = 0; count <= 40; ++count) {
+        for (int i = 0; i < count; ++i) values[i] = (i * 7) % 11;   ///< Values repeat.
+        for (int key = -1; key <= 11; ++key) {
+            int expected = -1;
+            for (int i = 0; i < count; ++i) {
+                if (values[i] == key) expected = i;
+            }
+            CHECK(findSlot(values, count, key) == expected);
+        }
+    }
+}
+
+// ----------- COMPRESSED GRAPH TESTS -----------
+
+/**
+ * Test the delta/varint compressed read-only graph.
+ */
+TEST_CASE("Compressed graph") {
+    SUBCASE("Queries match the source graph") {
+        Graph g(6);
+        g.addEdge(0, 5, 300);
+        g.addEdge(0, 1, -4);
+        g.addEdge(2, 1, 7);
+        g.addEdge(2, 1, 9);       ///< Parallel edge.
+        g.addEdge(3, 4, 0);
+
+        CompressedGraph c(g);
+        CHECK(c.getNumVertices() == 6);
+        CHECK(c.countEdges() == g.countEdges());
+        CHECK(c.getNeighborCount(1) == 3);
+        CHECK(c.getEdgeWeight(0, 5) == 300);
+        CHECK(c.getEdgeWeight(1, 0) == -4);
+        CHECK(c.getEdgeWeight(3, 4) == 0);
+        CHECK(c.getEdgeWeight(0, 2) == -1);
+        CHECK(c.containsEdge(5, 0));
+        CHECK_FALSE(c.containsEdge(4, 5));
+        CHECK_FALSE(c.containsEdge(0, 6));
+
+        int* neighbors = c.getNeighbors(0);
+        CHECK(neighbors[0] == 1);    ///< Neighbors come out sorted.
+        CHECK(neighbors[1] == 5);
+        delete[] neighbors;
+    }
+
+    SUBCASE("Sparse graph compresses to a few bytes per edge") {
+        const int n = 1000;
+        Graph g(n);
+        for (int v = 0; v < n; ++v) {
+            for (int k = 1; k <= 3; ++k) g.addEdge(v, (v + k) % n, (v + k) % 10 + 1);
+        }
+
+        CompressedGraph c(g);
+        CHECK(c.countEdges() == 3 * n);
+        long long payload = c.sizeInBytes() - (n + 1) * static_cast<long long>(sizeof(long long));
+        CHECK(payload <= 3 * 2 * 3 * n);    ///< At most 3 bytes per stored edge.
+
+        Graph primG = Algorithms::prim(g);
+        Graph primC = Algorithms::prim(c);
+        Graph kruskalC = Algorithms::kruskal(c);
+        CHECK(primC.countEdges() == n - 1);
+        CHECK(totalWeight(primC) == totalWeight(primG));
+        CHECK(totalWeight(kruskalC) == totalWeight(primG));
+
+        Graph bfsC = Algorithms::bfs(c, 0);
+        Graph dijkstraC = Algorithms::dijkstra(c, 0);
+        CHECK(bfsC.countEdges() == n - 1);
+        CHECK(dijkstraC.countEdges() == n - 1);
+    }
+
+    SUBCASE("Built straight from sorted arcs") {
+        const int n = 300;
+        Graph g(n);
+        for (int v = 0; v < n; ++v) {
+            for (int k = 1; k <= 4; ++k) g.addEdge(v, (v * k + 7) % n, v % 5 - 2);
+        }
+        g.addEdge(9, 9, 3);
+
+        long long count = 0;
+        Graph::Edge* arcs = new Graph::Edge[2 * g.countEdges()];
+        for (int v = 0; v < n; ++v) {
+            int degree = g.getNeighborCount(v);
+            int* neighbors = g.getNeighbors(v);
+            int* weights = g.getNeighborWeights(v);
+            for (int i = 0; i < degree; ++i) arcs[count + i] = {v, neighbors[i], weights[i]};
+            std::sort(arcs + count, arcs + count + degree, [](const Graph::Edge& a, const Graph::Edge& b) {
+                return a.dest < b.dest || (a.dest == b.dest && a.weight < b.weight);
+            });
+            count += degree;
+            delete[] neighbors;
+            delete[] weights;
+        }
+        CompressedGraph fromGraph(g);
+        CompressedGraph fromArcs(n, arcs, count);
+        CHECK(fromArcs.countEdges() == g.countEdges());
+        CHECK(fromArcs.sizeInBytes() == fromGraph.sizeInBytes());
+        CHECK(fromArcs.getNeighborCount(9) == g.getNeighborCount(9));
+        long long mismatched = 0;   ///< Rows compared as sorted pairs; parallel copies tie on dest.
+        for (int v = 0; v < n; ++v) {
+            int degree = fromArcs.getNeighborCount(v);
+            CHECK(degree == fromGraph.getNeighborCount(v));
+            int* neighbors[2] = {fromArcs.getNeighbors(v), fromGraph.getNeighbors(v)};
+            int* weights[2] = {fromArcs.getNeighborWeights(v), fromGraph.getNeighborWeights(v)};
+            long long* pairs[2] = {new long long[degree], new long long[degree]};
+            for (int side = 0; side < 2; ++side) {
+                for (int i = 0; i < degree; ++i) pairs[side][i] = static_cast<long long>(neighbors[side][i]) * 1000 + weights[side][i];
+                std::sort(pairs[side], pairs[side] + degree);
+            }
+            for (int i = 0; i < degree; ++i) mismatched += pairs[0][i] != pairs[1][i];
+            for (int side = 0; side < 2; ++side) {
+                delete[] neighbors[side];
+                delete[] weights[side];
+                delete[] pairs[side];
+            }
+        }
+        CHECK(mismatched == 0);
+
+        CompressedGraph directed(n, arcs, count, Direction::DIRECTED);
+        CHECK(directed.countEdges() == count);
+        std::swap(arcs[0], arcs[count - 1]);
+        CHECK_THROWS_AS(CompressedGraph(n, arcs, count), std::invalid_argument);
+        arcs[0].dest = n;
+        CHECK_THROWS_AS(CompressedGraph(n, arcs, count), std::out_of_range);
+        delete[] arcs;
+    }
+
+    SUBCASE("Built row by row") {
+        const int n = 200;
+        Graph g(n);
+        for (int v = 0; v < n; ++v) {
+            for (int k = 1; k <= 3; ++k) g.addEdge(v, (v * 7 + k * 13) % n, v % 9 - 4);
+        }
+        CompressedGraph whole(g);
+        CompressedGraph rows(n);
+        CHECK(rows.countEdges() == 0);
+        for (int v = 0; v < n; ++v) {
+            int degree = whole.getNeighborCount(v);
+            int* neighbors = whole.getNeighbors(v);
+            int* weights = whole.getNeighborWeights(v);
+            rows.appendRow(neighbors, weights, degree);
+            delete[] neighbors;
+            delete[] weights;
+            if (v == n / 2) {
+                CHECK(rows.rowCount() == n / 2 + 1);
+                CHECK(rows.getNeighborCount(n - 1) == 0);     ///< Not appended yet.
+                CHECK(rows.getEdgeWeight(n - 1, 0) == -1);
+            }
+        }
+        CHECK(rows.countEdges() == g.countEdges());
+        CHECK(rows.sizeInBytes() == whole.sizeInBytes());
+        long long mismatched = 0;
+        for (int v = 0; v < n; ++v) {
+            int degree = rows.getNeighborCount(v);
+            int* a = rows.getNeighbors(v);
+            int* b = whole.getNeighbors(v);
+            int* wa = rows.getNeighborWeights(v);
+            int* wb = whole.getNeighborWeights(v);
+            for (int i = 0; i < degree; ++i) mismatched += a[i] != b[i] || wa[i] != wb[i];
+            delete[] a;
+            delete[] b;
+            delete[] wa;
+            delete[] wb;
+        }
+        CHECK(mismatched == 0);
+        int one[1] = {0};
+        CHECK_THROWS_AS(rows.appendRow(one, one, 1), std::logic_error);
+
+        CompressedGraph bad(3, Direction::DIRECTED);
+        int unsorted[2] = {2, 1};
+        int outside[1] = {3};
+        CHECK_THROWS_AS(bad.appendRow(unsorted, unsorted, 2), std::invalid_argument);
+        CHECK_THROWS_AS(bad.appendRow(outside, outside, 1), std::out_of_range);
+        CHECK(bad.rowCount() == 0);
+    }
+}
+
+// ----------- DENSE GRAPH TESTS -----------
+
+/**
+ * Test the bit-matrix dense graph representation.
+ */
+TEST_CASE("Dense bitmap graph") {
+    SUBCASE("Edges across word boundaries") {
+        DenseGraph g(130);
+        g.addEdge(0, 63, 5);
+        g.addEdge(0, 64, 6);
+        g.addEdge(0, 129, 7);
+        g.addEdge(63, 64, 8);
+
+        CHECK(g.containsEdge(64, 0));
+        CHECK(g.containsEdge(129, 0));
+        CHECK_FALSE(g.containsEdge(0, 62));
+        CHECK_FALSE(g.containsEdge(0, 130));
+        CHECK(g.getEdgeWeight(0, 129) == 7);
+        CHECK(g.getNeighborCount(0) == 3);
+        CHECK(g.countEdges() == 4);
+
+        int* neighbors = g.getNeighbors(0);
+        int* weights = g.getNeighborWeights(0);
+        CHECK(neighbors[0] == 63);
+        CHECK(neighbors[2] == 129);
+        CHECK(weights[1] == 6);
+        delete[] neighbors;
+        delete[] weights;
+
+        g.addEdge(0, 63, 9);    ///< Overwrites the weight.
+        CHECK(g.getEdgeWeight(63, 0) == 9);
+        CHECK(g.countEdges() == 4);
+
+        g.removeEdge(64, 0);
+        CHECK_FALSE(g.containsEdge(0, 64));
+        CHECK(g.getNeighborCount(64) == 1);
+        CHECK_THROWS_AS(g.removeEdge(0, 64), std::runtime_error);
+    }
+
+    SUBCASE("Self-loops count as in the list graph") {
+        Graph g(70);
+        g.addEdge(3, 3, 2);
+        g.addEdge(3, 65, 4);
+        g.addEdge(65, 65, 6);
+        DenseGraph d(g);
+        CHECK(d.countEdges() == g.countEdges());
+        CHECK(d.countEdges() == 3);
+        CHECK(d.getNeighborCount(3) == 2);   ///< Graph lists the loop twice, a bit matrix once.
+        CHECK(d.getEdgeWeight(65, 65) == 6);
+        d.removeEdge(3, 3);
+        g.removeEdge(3, 3);
+        CHECK(d.countEdges() == g.countEdges());
+
+        DenseGraph directed(4, Direction::DIRECTED);
+        directed.addEdge(1, 1, 1);
+        directed.addEdge(1, 2, 1);
+        CHECK(directed.countEdges() == 2);
+    }
+
+    SUBCASE("Algorithms agree with the list graph") {
+        const int n = 40;
+        Graph g(n);
+        for (int u = 0; u < n; ++u) {
+            for (int v = u + 1; v < n; ++v) {
+                if ((u * 31 + v * 17) % 3 != 0) g.addEdge(u, v, (u * v) % 13 + 1);
+            }
+        }
+
+        DenseGraph d(g);
+        CHECK(d.countEdges() == g.countEdges());
+        CHECK(totalWeight(Algorithms::prim(d)) == totalWeight(Algorithms::prim(g)));
+        CHECK(totalWeight(Algorithms::kruskal(d)) == totalWeight(Algorithms::kruskal(g)));
+        CHECK(Algorithms::bfs(d, 0).countEdges() == n - 1);
+        CHECK(Algorithms::dfs(d, 0).countEdges() == n - 1);
+        CHECK(Algorithms::dijkstra(d, 0).countEdges() == n - 1);
+    }
+}
+
+/**
+ * Test per-vertex encoding changes driven by the storage policy.
+ */
+TEST_CASE("Adaptive per-vertex encoding") {
+    StoragePolicy policy;
+    policy.hashThreshold = 8;
+    policy.hashRelease = 4;
+    policy.denseMinVertices = 64;
+    policy.denseRatio = 0.25;
+    policy.denseReleaseRatio = 0.125;
+
+    const int n = 128;
+    Graph g(n, policy);
+
+    for (int v = 1; v <= 8; ++v) g.addEdge(0, v, v);
+    CHECK(g.getEncoding(0) == AdjacencyList::Encoding::LIST);
+    g.addEdge(0, 9, 9);
+    CHECK(g.getEncoding(0) == AdjacencyList::Encoding::HASHED);
+
+    for (int v = 10; v < 58; ++v) g.addEdge(0, v, v);
+    CHECK(g.getEncoding(0) == AdjacencyList::Encoding::HASHED);   ///< Past a quarter, but int weights need more.
+    g.addEdge(0, 58, 58);   ///< 58 / 128 >= (1/8 + 4) / (128 / 14) bytes.
+    CHECK(g.getEncoding(0) == AdjacencyList::Encoding::DENSE);
+    CHECK(g.getEncoding(1) == AdjacencyList::Encoding::INLINE);
+    CHECK(g.getNeighborCount(0) == 58);
+    CHECK(g.getEdgeWeight(0, 17) == 17);
+    CHECK(g.containsEdge(0, 58));
+    CHECK_FALSE(g.containsEdge(0, 59));
+
+    int* neighbors = g.getNeighbors(0);
+    int* weights = g.getNeighborWeights(0);
+    for (int i = 0; i < 58; ++i) {
+        CHECK(neighbors[i] == i + 1);
+        CHECK(weights[i] == i + 1);
+    }
+    delete[] neighbors;
+    delete[] weights;
+
+    SUBCASE("Parallel edge demotes a dense row") {
+        g.addEdge(0, 5, 50);
+        CHECK(g.getEncoding(0) == AdjacencyList::Encoding::HASHED);
+        CHECK(g.getNeighborCount(0) == 59);
+        g.removeEdge(0, 5);
+        CHECK(g.containsEdge(0, 5));
+    }
+
+    SUBCASE("Removals walk back through the encodings") {
+        for (int v = 58; v >= 30; --v) g.removeEdge(0, v);
+        CHECK(g.getEncoding(0) == AdjacencyList::Encoding::DENSE);
+        g.removeEdge(0, 29);    ///< Below the release ratio, raised by the same factor.
+        CHECK(g.getEncoding(0) == AdjacencyList::Encoding::HASHED);
+        for (int v = 28; v >= 4; --v) g.removeEdge(0, v);
+        CHECK(g.getEncoding(0) == AdjacencyList::Encoding::LIST);
+        CHECK(g.getNeighborCount(0) == 3);
+        CHECK(g.getEdgeWeight(0, 2) == 2);
+        CHECK(g.countEdges() == 3);
+    }
+}
+
+/**
+ * Test inline storage of low-degree adjacency lists.
+ */
+TEST_CASE("Inline small-degree storage") {
+    CHECK(sizeof(AdjacencyList) <= 48);
+
+    AdjacencyList list;
+    for (int v = 0; v < AdjacencyList::INLINE_CAPACITY; ++v) list.addEdge(v, 10 * v);
+    CHECK(list.encoding() == AdjacencyList::Encoding::INLINE);
+    CHECK(list.getHead() == nullptr);   ///< No heap block yet.
+    CHECK(list.contains(3));
+    CHECK(list.getWeight(2) == 20);
+    CHECK(list.getWeight(9) == -1);
+
+    int* neighbors = list.getAllNeighbors();
+    CHECK(neighbors[0] == 3);           ///< Newest first, as in blocks.
+    CHECK(neighbors[3] == 0);
+    delete[] neighbors;
+
+    SUBCASE("Overflow spills to a block") {
+        list.addEdge(4, 40);
+        CHECK(list.encoding() == AdjacencyList::Encoding::LIST);
+        CHECK(list.getHead()->used == 5);
+        CHECK(list.getWeight(0) == 0);
+        CHECK(list.getWeight(4) == 40);
+
+        list.removeEdge(1);
+        list.removeEdge(4);
+        CHECK(list.encoding() == AdjacencyList::Encoding::LIST);
+        list.removeEdge(0);
+        CHECK(list.encoding() == AdjacencyList::Encoding::INLINE);
+        CHECK(list.count() == 2);
+        CHECK(list.getWeight(2) == 20);
+        CHECK(list.getWeight(3) == 30);
+    }
+
+    SUBCASE("Removal inside the inline storage") {
+        list.removeEdge(1);
+        CHECK(list.count() == 3);
+        CHECK_FALSE(list.contains(1));
+        CHECK(list.getWeight(3) == 30);
+        CHECK_THROWS(list.removeEdge(1));
+    }
+}
+
+// ----------- TEMPLATED TYPE TESTS -----------
+
+/**
+ * Test graphs over other vertex ID and weight types.
+ */
+TEST_CASE("Templated vertex and weight types") {
+    SUBCASE("64-bit IDs with byte weights") {
+        BasicGraph<uint64_t, uint8_t> g(6);
+        g.addEdge(0, 1, 200);
+        g.addEdge(1, 2, 250);
+        g.addEdge(0, 2, 255);
+        g.addEdge(2, 3, 1);
+        CHECK(g.getEdgeWeight(1, 2) == 250);
+        CHECK(g.getEdgeWeight(0, 5) == 255);   ///< none<uint8_t>() for a missing edge.
+        CHECK_FALSE(g.containsEdge(0, 5));
+        CHECK(g.countEdges() == 4);
+
+        BasicGraph<uint64_t, uint8_t> tree = Algorithms::dijkstra(g, 0);
+        CHECK(tree.containsEdge(0, 2));         ///< 255 beats 200 + 250 without wrapping.
+        CHECK_FALSE(tree.containsEdge(1, 2));
+
+        BasicGraph<uint64_t, uint8_t> mst = Algorithms::kruskal(g);
+        CHECK(mst.countEdges() == 3);
+        CHECK_FALSE(mst.containsEdge(0, 2));
+    }
+
+    SUBCASE("Unsigned IDs reject out-of-range vertices") {
+        BasicGraph<uint32_t, double> g(3);
+        g.addEdge(0, 1, 0.5);
+        g.addEdge(1, 2, 0.25);
+        g.addEdge(0, static_cast<uint32_t>(-1), 1.0);   ///< Prints "Invalid edge!".
+        CHECK(g.countEdges() == 2);
+        CHECK(g.getEdgeWeight(1, 2) == doctest::Approx(0.25));
+        CHECK(g.getNeighborCount(static_cast<uint32_t>(-1)) == 0);
+
+        BasicGraph<uint32_t, double> tree = Algorithms::prim(g);
+        CHECK(tree.getEdgeWeight(0, 1) == doctest::Approx(0.5));
+        CHECK(tree.getEdgeWeight(2, 1) == doctest::Approx(0.25));
+    }
+
+    SUBCASE("Path lengths past 2^31") {
+        BasicGraph<int, int> g(4);
+        g.addEdge(0, 1, 2000000000);
+        g.addEdge(1, 2, 2000000000);
+        g.addEdge(0, 3, 1);
+        g.addEdge(3, 2, 2100000000);
+        Graph tree = Algorithms::dijkstra(g, 0);
+        CHECK(tree.containsEdge(3, 2));         ///< 2.1e9 + 1 < 4e9, compared in 64 bits.
+        CHECK_FALSE(tree.containsEdge(1, 2));
+    }
+
+    SUBCASE("64-bit IDs through every encoding") {
+        BasicGraph<uint64_t, int64_t> g(300);
+        for (uint64_t v = 1; v < 150; ++v) g.addEdge(0, v, static_cast<int64_t>(v) << 33);
+        CHECK(g.getEncoding(0) == BasicGraph<uint64_t, int64_t>::List::Encoding::DENSE);
+        CHECK(g.getEdgeWeight(0, 149) == static_cast<int64_t>(149) << 33);
+        for (uint64_t v = 149; v >= 3; --v) g.removeEdge(0, v);
+        CHECK(g.getEncoding(0) == BasicGraph<uint64_t, int64_t>::List::Encoding::INLINE);
+        CHECK(g.getEdgeWeight(0, 2) == static_cast<int64_t>(2) << 33);
+    }
+
+    SUBCASE("64-bit SIMD search") {
+        long long values[9] = {1, 5LL << 40, 3, 7, 5LL << 40, 9, -1, 11, 13};
+        CHECK(findSlot(values, 9, 5LL << 40) == 4);
+        CHECK(findSlot(values, 9, -1LL) == 6);
+        CHECK(findSlot(values, 9, 13LL) == 8);
+        CHECK(findSlot(values, 9, 5LL) == -1);
+        CHECK(findSlot(values, 1, 1LL) == 0);
+    }
+}
+
+/**
+ * Test graphs that store no weights.
+ */
+TEST_CASE("Unweighted graphs") {
+    CHECK(BasicBlock<int, Unweighted>::CAPACITY == 2 * Block::CAPACITY);
+
+    BasicGraph<int, Unweighted> g(300);
+    g.addEdge(0, 1);
+    g.addEdge(1, 2);
+    g.addEdge(2, 3);
+    g.addEdge(0, 3, 7);                     ///< The weight is ignored.
+    g.addEdge(4, 5);
+    CHECK(g.getEdgeWeight(0, 3) == 1);
+    CHECK(g.getEdgeWeight(0, 2) == -1);
+    CHECK(g.getNeighborWeights(0) == nullptr);
+    CHECK(g.countEdges() == 5);
+
+    SUBCASE("Dijkstra is a BFS") {
+        BasicGraph<int, Unweighted> tree = Algorithms::dijkstra(g, 0);
+        CHECK(tree.countEdges() == 3);
+        CHECK(tree.containsEdge(0, 3));     ///< One hop, not three.
+        CHECK(tree.containsEdge(0, 1));
+    }
+
+    SUBCASE("Spanning forests") {
+        BasicGraph<int, Unweighted> mst = Algorithms::kruskal(g);
+        CHECK(mst.countEdges() == 4);       ///< One edge of the 0-1-2-3 cycle is dropped.
+        CHECK(mst.containsEdge(4, 5));
+        BasicGraph<int, Unweighted> prim = Algorithms::prim(g);
+        CHECK(prim.countEdges() == 3);      ///< Component of vertex 0 only.
+    }
+
+    SUBCASE("Blocks and dense rows without weights") {
+        for (int v = 6; v < 120; ++v) g.addEdge(0, v);
+        CHECK(g.getEncoding(0) == BasicGraph<int, Unweighted>::List::Encoding::DENSE);
+        CHECK(g.getEdgeWeight(0, 100) == 1);
+        for (int v = 119; v >= 40; --v) g.removeEdge(0, v);
+        CHECK(g.getEncoding(0) == BasicGraph<int, Unweighted>::List::Encoding::HASHED);
+        CHECK(g.containsEdge(0, 39));
+        CHECK_FALSE(g.containsEdge(0, 40));
+        CHECK(g.getNeighborCount(0) == 36);
+    }
+}
+
+// ----------- DIRECTED GRAPH TESTS -----------
+
+/**
+ * Test directed graphs and their reverse index.
+ */
+TEST_CASE("Directed graphs") {
+    Graph g(5, Direction::DIRECTED);
+    g.addEdge(0, 1, 4);
+    g.addEdge(1, 2, 1);
+    g.addEdge(0, 2, 7);
+    g.addEdge(3, 0, 2);
+    CHECK(g.isDirected());
+    CHECK(g.containsEdge(0, 1));
+    CHECK_FALSE(g.containsEdge(1, 0));     ///< No mirrored copy.
+    CHECK(g.countEdges() == 4);
+    CHECK(g.getNeighborCount(2) == 0);
+    CHECK_THROWS(g.removeEdge(1, 0));
+
+    SUBCASE("In-edges from the lazy reverse index") {
+        CHECK(g.getInNeighborCount(2) == 2);
+        CHECK(g.getInNeighborCount(3) == 0);
+        int* sources = g.getInNeighbors(2);
+        int* weights = g.getInNeighborWeights(2);
+        CHECK(sources[0] + sources[1] == 1);
+        CHECK(weights[0] + weights[1] == 8);
+        delete[] sources;
+        delete[] weights;
+
+        g.removeEdge(0, 2);                ///< Invalidates the index.
+        g.addEdge(4, 2, 9);
+        CHECK(g.getInNeighborCount(2) == 2);
+        CHECK(g.getInNeighborCount(0) == 1);
+        sources = g.getInNeighbors(2);
+        CHECK(sources[0] + sources[1] == 5);
+        delete[] sources;
+    }
+
+    SUBCASE("Concurrent readers build the reverse index once") {
+        std::atomic<int> wrong(0);
+        std::thread readers[4];
+        for (std::thread& reader : readers) {
+            reader = std::thread([&] {
+                if (g.getInNeighborCount(2) != 2) wrong++;
+                int* sources = g.getInNeighbors(0);
+                if (sources[0] != 3) wrong++;
+                delete[] sources;
+            });
+        }
+        for (std::thread& reader : readers) reader.join();
+        CHECK(wrong == 0);
+    }
+
+    SUBCASE("Traversals follow arc direction") {
+        Graph bfsTree = Algorithms::bfs(g, 0);
+        CHECK(bfsTree.isDirected());
+        CHECK(bfsTree.containsEdge(0, 1));
+        CHECK_FALSE(bfsTree.containsEdge(1, 0));
+        CHECK(bfsTree.countEdges() == 2);  ///< Vertex 3 is not reachable from 0.
+
+        Graph dfsTree = Algorithms::dfs(g, 3);
+        CHECK(dfsTree.countEdges() == 3);
+
+        Graph spt = Algorithms::dijkstra(g, 0);
+        CHECK(spt.containsEdge(1, 2));     ///< 4 + 1 beats the direct arc of 7.
+        CHECK_FALSE(spt.containsEdge(0, 2));
+        CHECK(spt.countEdges() == 2);
+    }
+
+    SUBCASE("Spanning trees reject directed graphs") {
+        CHECK_THROWS_AS(Algorithms::prim(g), std::invalid_argument);
+        CHECK_THROWS_AS(Algorithms::kruskal(g), std::invalid_argument);
+    }
+
+    SUBCASE("Copies keep the direction") {
+        CompressedGraph compressed(g);
+        CHECK(compressed.countEdges() == 4);
+        CHECK_FALSE(compressed.containsEdge(1, 0));
+        DenseGraph dense(g);
+        CHECK(dense.countEdges() == 4);
+        dense.addEdge(2, 4);
+        CHECK_FALSE(dense.containsEdge(4, 2));
+    }
+
+    SUBCASE("Undirected graphs answer in-edge queries from their lists") {
+        Graph u(3);
+        u.addEdge(0, 1, 5);
+        CHECK(u.getInNeighborCount(1) == 1);
+        int* weights = u.getInNeighborWeights(1);
+        CHECK(weights[0] == 5);
+        delete[] weights;
+    }
+}
+
+// ----------- EDGE TABLE GRAPH TESTS -----------
+
+/**
+ * Test the edge-table graph and its edge IDs.
+ */
+TEST_CASE("Edge table graph") {
+    EdgeTableGraph g(6);
+    int a = g.addEdge(0, 1, 4);
+    int b = g.addEdge(1, 2, 3);
+    int c = g.addEdge(0, 2, 10);
+    int loop = g.addEdge(3, 3, 1);
+    g.addEdge(4, 5, 2);
+    CHECK(g.addEdge(0, 9) == -1);
+    CHECK(g.countEdges() == 5);
+    CHECK(g.getEdgeId(2, 1) == b);
+    CHECK(g.getNeighborCount(3) == 2);      ///< Self-loop counted from both sides, as in Graph.
+
+    SUBCASE("Weight updates are seen from both endpoints") {
+        g.setEdgeWeight(c, 1);
+        CHECK(g.getEdgeWeight(0, 2) == 1);
+        CHECK(g.getEdgeWeight(2, 0) == 1);
+        CHECK(g.getWeightById(c) == 1);
+        Graph spt = Algorithms::dijkstra(g, 0);
+        CHECK(spt.containsEdge(0, 2));
+        CHECK_FALSE(spt.containsEdge(1, 2));
+    }
+
+    SUBCASE("Removal by ID and ID reuse") {
+        g.removeEdgeById(a);
+        CHECK_FALSE(g.containsEdge(1, 0));
+        CHECK_FALSE(g.hasEdgeId(a));
+        CHECK_THROWS(g.removeEdgeById(a));
+        CHECK(g.getNeighborCount(1) == 1);
+        CHECK(g.getEdgeWeight(2, 1) == 3);  ///< The moved half-edge still resolves.
+
+        g.removeEdgeById(loop);
+        CHECK(g.getNeighborCount(3) == 0);
+        CHECK_FALSE(g.hasEdgeId(loop));     ///< Freed IDs link through their entries.
+        CHECK(g.addEdge(3, 4, 6) == loop);  ///< Most recently freed ID first.
+        CHECK(g.addEdge(1, 4, 8) == a);     ///< Then the one freed before it.
+        CHECK(g.getEdgeWeight(4, 1) == 8);
+        CHECK(g.countEdges() == 5);
+
+        g.removeEdge(2, 0);
+        CHECK_THROWS(g.removeEdge(2, 0));
+        CHECK(g.getNeighborCount(0) == 0);
+    }
+
+    SUBCASE("Incident edge IDs and algorithms") {
+        int* ids = g.getIncidentEdges(0);
+        int* neighbors = g.getNeighbors(0);
+        for (int i = 0; i < g.getNeighborCount(0); ++i) {
+            CHECK(g.getEdgeId(0, neighbors[i]) == ids[i]);
+        }
+        delete[] ids;
+        delete[] neighbors;
+
+        Graph mst = Algorithms::kruskal(g);
+        CHECK(mst.countEdges() == 3);
+        CHECK(totalWeight(mst) == 9);
+        CHECK(totalWeight(Algorithms::prim(g)) == 7);
+    }
+
+    SUBCASE("Many edges grow the table") {
+        EdgeTableGraph big(50);
+        for (int u = 0; u < 50; ++u)
+            for (int v = u + 1; v < 50; v += 3) big.addEdge(u, v, u + v);
+        long long expected = big.countEdges();
+        for (int u = 0; u < 50; u += 2) {
+            while (big.getNeighborCount(u) > 0) {
+                int* ids = big.getIncidentEdges(u);
+                big.removeEdgeById(ids[0]);
+                delete[] ids;
+                expected--;
+            }
+        }
+        CHECK(big.countEdges() == expected);
+        CHECK(big.getEdgeWeight(1, 2) == -1);   ///< Even endpoints lost all their edges.
+        CHECK(big.getEdgeWeight(1, 5) == 6);
+    }
+}
+
+// ----------- BULK CONSTRUCTION TESTS -----------
+
+/**
+ * Test building a graph from an edge list in one go.
+ */
+TEST_CASE("Bulk edge-list construction") {
+    const int n = 300;
+    const int m = 2000;
+    Graph::Edge* edges = new Graph::Edge[m];
+    for (int i = 0; i < m; ++i) {
+        if (i % 7 == 0) {
+            edges[i] = {0, i / 7 + 1, i % 50};      ///< Vertex 0 becomes a dense hub.
+        } else {
+            edges[i] = {1 + (i * 37) % (n - 1), 1 + (i * 101 + 13) % (n - 1), i % 50};
+        }
+    }
+
+    Graph bulk(n, edges, m);
+    Graph incremental(n);
+    for (int i = 0; i < m; ++i) incremental.addEdge(edges[i].src, edges[i].dest, edges[i].weight);
+
+    auto sameLists = [&](const Graph& a, const Graph& b) {
+        for (int v = 0; v < n; ++v) {
+            REQUIRE(a.getNeighborCount(v) == b.getNeighborCount(v));
+            CHECK(a.getEncoding(v) == b.getEncoding(v));
+            int* na = a.getNeighbors(v);
+            int* nb = b.getNeighbors(v);
+            int* wa = a.getNeighborWeights(v);
+            int* wb = b.getNeighborWeights(v);
+            int mismatches = 0;
+            for (int i = 0; i < a.getNeighborCount(v); ++i) {
+                mismatches += (na[i] != nb[i]) + (wa[i] != wb[i]);
+            }
+            CHECK(mismatches == 0);
+            delete[] na;
+            delete[] nb;
+            delete[] wa;
+            delete[] wb;
+        }
+    };
+
+    SUBCASE("Same lists as repeated addEdge") {
+        CHECK(bulk.countEdges() == incremental.countEdges());
+        CHECK(bulk.getEncoding(0) == AdjacencyList::Encoding::DENSE);
+        sameLists(bulk, incremental);
+    }
+
+    SUBCASE("Arena blocks survive later edits") {
+        for (int i = 0; i < m; i += 3) {
+            bulk.removeEdge(edges[i].src, edges[i].dest);
+            incremental.removeEdge(edges[i].src, edges[i].dest);
+        }
+        for (int i = 0; i < 500; ++i) {
+            bulk.addEdge(i % n, (i * 7) % n, i);
+            incremental.addEdge(i % n, (i * 7) % n, i);
+        }
+        sameLists(bulk, incremental);
+    }
+
+    SUBCASE("Directed edge lists") {
+        Graph directed(n, edges, m, Direction::DIRECTED);
+        CHECK(directed.countEdges() == m);
+        CHECK(directed.getNeighborCount(0) == (m + 6) / 7);
+        CHECK(directed.getInNeighborCount(0) == 0);
+    }
+
+    SUBCASE("Invalid vertices throw") {
+        Graph::Edge bad[2] = {{0, 1, 1}, {1, n, 1}};
+        CHECK_THROWS_AS(Graph(n, bad, 2), std::out_of_range);
+        CHECK_THROWS_AS(Graph(n, bad, 2, Direction::UNDIRECTED, StoragePolicy(), 2), std::out_of_range);
+    }
+
+    SUBCASE("Parallel construction matches the serial result") {
+        for (unsigned threads : {2u, 3u, 8u, 0u}) {
+            Graph parallel(n, edges, m, Direction::UNDIRECTED, StoragePolicy(), threads);
+            CHECK(parallel.countEdges() == incremental.countEdges());
+            sameLists(parallel, incremental);
+        }
+        Graph tiny(4, edges + 7, 1, Direction::UNDIRECTED, StoragePolicy(), 8);   ///< More threads than edges.
+        CHECK(tiny.countEdges() == 1);
+        CHECK(tiny.getEdgeWeight(2, 0) == 7);
+    }
+
+    SUBCASE("Construction on a shared work pool") {
+        WorkPool pool(4);
+        for (int round = 0; round < 2; ++round) {   ///< The pool is reused.
+            Graph pooled(n, edges, m, Direction::UNDIRECTED, StoragePolicy(), pool);
+            CHECK(pooled.countEdges() == incremental.countEdges());
+            sameLists(pooled, incremental);
+        }
+        Graph::Edge bad[2] = {{0, 1, 1}, {1, n, 1}};
+        CHECK_THROWS_AS(Graph(n, bad, 2, Direction::UNDIRECTED, StoragePolicy(), pool), std::out_of_range);
+    }
+
+    delete[] edges;
+}
+
+// ----------- SNAPSHOT TESTS -----------
+
+/**
+ * Test writing a snapshot and reading it back through mmap.
+ */
+TEST_CASE("Binary snapshots") {
+    const char* path = "snapshot_test.bin";
+    Graph g(6);
+    g.addEdge(0, 3, 4);
+    g.addEdge(0, 1, 2);
+    g.addEdge(1, 2, 5);
+    g.addEdge(3, 4, 1);
+    g.addEdge(4, 4, 9);
+    writeSnapshot(g, path);
+
+    SUBCASE("round trip") {
+        SnapshotGraph s(path);
+        CHECK(s.verify());
+        CHECK(s.getNumVertices() == 6);
+        CHECK(s.countEdges() == g.countEdges());
+        CHECK(s.direction() == Direction::UNDIRECTED);
+        for (int v = 0; v < 6; ++v) {
+            CHECK(s.getNeighborCount(v) == g.getNeighborCount(v));
+            for (int u = 0; u < 6; ++u) {
+                CHECK(s.containsEdge(v, u) == g.containsEdge(v, u));
+                CHECK(s.getEdgeWeight(v, u) == g.getEdgeWeight(v, u));
+            }
+        }
+        const int* row = s.neighborsOf(0);     ///< Rows are sorted.
+        CHECK(row[0] == 1);
+        CHECK(row[1] == 3);
+        CHECK(s.weightsOf(0)[1] == 4);
+        CHECK(s.getNeighborCount(5) == 0);
+        CHECK(s.neighborsOf(6) == nullptr);
+        CHECK_FALSE(s.containsEdge(0, 6));
+
+        Graph tree = Algorithms::dijkstra(s, 0);
+        CHECK(tree.getEdgeWeight(1, 2) == 5);
+        CHECK(tree.countEdges() == 4);
+    }
+
+    SUBCASE("directed") {
+        Graph d(3, Direction::DIRECTED);
+        d.addEdge(0, 1, 7);
+        d.addEdge(2, 1, 3);
+        writeSnapshot(d, path);
+        SnapshotGraph s(path);
+        CHECK(s.direction() == Direction::DIRECTED);
+        CHECK(s.countEdges() == 2);
+        CHECK(s.containsEdge(2, 1));
+        CHECK_FALSE(s.containsEdge(1, 2));
+    }
+
+    SUBCASE("corruption") {
+        std::FILE* file = std::fopen(path, "r+b");
+        std::fseek(file, -1, SEEK_END);        ///< Last weight byte.
+        std::fputc(0x7f, file);
+        std::fclose(file);
+        SnapshotGraph s(path);
+        CHECK_FALSE(s.verify());
+
+        const long long destStart = sizeof(SnapshotHeader) + 7 * sizeof(long long);
+        int bad = 6;
+        file = std::fopen(path, "r+b");
+        std::fseek(file, destStart, SEEK_SET); ///< First destination, one past the last vertex.
+        std::fwrite(&bad, sizeof(bad), 1, file);
+        std::fclose(file);
+        CHECK_FALSE(SnapshotGraph(path).verify());   ///< Opening alone reads no destinations.
+        CHECK_THROWS_AS(SnapshotGraph(path, true), std::runtime_error);
+
+        writeSnapshot(g, path);
+        long long backwards = 100;
+        file = std::fopen(path, "r+b");
+        std::fseek(file, sizeof(SnapshotHeader) + sizeof(long long), SEEK_SET);   ///< offsets[1].
+        std::fwrite(&backwards, sizeof(backwards), 1, file);
+        std::fclose(file);
+        CHECK_FALSE(SnapshotGraph(path).verify());
+        CHECK_THROWS_AS(SnapshotGraph(path, true), std::runtime_error);
+
+        writeSnapshot(g, path);
+        file = std::fopen(path, "r+b");
+        std::fseek(file, sizeof(SnapshotHeader) + 6 * sizeof(long long), SEEK_SET);   ///< offsets[6], the end.
+        std::fwrite(&backwards, sizeof(backwards), 1, file);
+        std::fclose(file);
+        CHECK_THROWS_AS(SnapshotGraph{path}, std::runtime_error);
+
+        file = std::fopen(path, "r+b");
+        std::fputc('X', file);                 ///< Magic.
+        std::fclose(file);
+        CHECK_THROWS_AS(SnapshotGraph{path}, std::runtime_error);
+        CHECK_THROWS_AS(SnapshotGraph("no_such_snapshot.bin"), std::runtime_error);
+    }
+
+    std::remove(path);
+}
+
+// ----------- TEXT LOADER TESTS -----------
+
+/// Write text to a file for the loader tests.
+static void writeFile(const char* path, const std::string& text) {
+    std::FILE* file = std::fopen(path, "wb");
+    std::fwrite(text.data(), 1, text.size(), file);
+    std::fclose(file);
+}
+
+/**
+ * Test the SNAP, DIMACS and Matrix Market loaders.
+ */
+TEST_CASE("Text graph loaders") {
+    const char* path = "loader_test.txt";
+
+    SUBCASE("SNAP edge list") {
+        writeFile(path, "# nodes 4\n0 1\n1\t2 5\r\n\n% note\n  3 0 7  \n");
+        Graph g = readEdgeList(path);
+        CHECK(g.getNumVertices() == 4);
+        CHECK(g.countEdges() == 3);
+        CHECK(g.getEdgeWeight(1, 0) == 1);
+        CHECK(g.getEdgeWeight(2, 1) == 5);
+        CHECK(g.getEdgeWeight(0, 3) == 7);
+
+        Graph d = readEdgeList(path, Direction::DIRECTED);
+        CHECK(d.containsEdge(3, 0));
+        CHECK_FALSE(d.containsEdge(0, 3));
+
+        writeFile(path, "0 1\n2 x\n");
+        CHECK_THROWS_AS(readEdgeList(path), std::runtime_error);
+        writeFile(path, "0 -1\n");
+        CHECK_THROWS_AS(readEdgeList(path), std::runtime_error);
+        writeFile(path, "0 1 2 3\n");
+        CHECK_THROWS_AS(readEdgeList(path), std::runtime_error);
+        writeFile(path, "");
+        CHECK(readEdgeList(path).getNumVertices() == 0);
+        CHECK_THROWS_AS(readEdgeList("no_such_file.txt"), std::runtime_error);
+    }
+
+    SUBCASE("DIMACS") {
+        writeFile(path, "c road network\np sp 3 2\nc arcs\na 1 2 4\na 3 1 2\n");
+        Graph g = readDimacs(path);
+        CHECK(g.isDirected());
+        CHECK(g.getNumVertices() == 3);
+        CHECK(g.getEdgeWeight(0, 1) == 4);
+        CHECK(g.getEdgeWeight(2, 0) == 2);
+        CHECK_FALSE(g.containsEdge(1, 0));
+
+        writeFile(path, "a 1 2 4\n");
+        CHECK_THROWS_AS(readDimacs(path), std::runtime_error);
+        writeFile(path, "p sp 3 1\na 1 4 4\n");
+        CHECK_THROWS_AS(readDimacs(path), std::runtime_error);
+    }
+
+    SUBCASE("Matrix Market") {
+        writeFile(path, "%%MatrixMarket matrix coordinate integer symmetric\n% comment\n3 3 2\n2 1 5\n3 3 1\n");
+        Graph g = readMatrixMarket(path);
+        CHECK_FALSE(g.isDirected());
+        CHECK(g.getEdgeWeight(0, 1) == 5);
+        CHECK(g.containsEdge(2, 2));
+
+        writeFile(path, "%%MatrixMarket matrix coordinate pattern general\n2 2 1\n1 2\n");
+        Graph p = readMatrixMarket(path);
+        CHECK(p.isDirected());
+        CHECK(p.getEdgeWeight(0, 1) == 1);
+        CHECK_FALSE(p.containsEdge(1, 0));
+
+        writeFile(path, "%%MatrixMarket matrix coordinate real general\n2 2 1\n1 2 0.5\n");
+        CHECK_THROWS_AS(readMatrixMarket(path), std::runtime_error);
+        writeFile(path, "%%MatrixMarket matrix coordinate pattern general\n2 3 1\n1 2\n");
+        CHECK_THROWS_AS(readMatrixMarket(path), std::runtime_error);
+    }
+
+    SUBCASE("parallel chunks") {
+        const int n = 5000;
+        std::string text = "# generated\n";
+        for (int i = 0; i < 40000; ++i) {
+            text += std::to_string(i * 7 % n) + " " + std::to_string(i * 13 % n) + " " +
+                    std::to_string(i % 100) + (i % 3 ? "\n" : "\r\n");
+        }
+        writeFile(path, text);
+        Graph serial = readEdgeList(path);
+        for (unsigned threads : {2u, 3u, 8u, 0u}) {
+            Graph parallel = readEdgeList(path, Direction::UNDIRECTED, threads);
+            REQUIRE(parallel.getNumVertices() == n);
+            int mismatches = 0;
+            for (int v = 0; v < n; ++v) {
+                int count = serial.getNeighborCount(v);
+                if (parallel.getNeighborCount(v) != count) {
+                    ++mismatches;
+                    continue;
+                }
+                int* a = serial.getNeighbors(v);
+                int* b = parallel.getNeighbors(v);
+                int* wa = serial.getNeighborWeights(v);
+                int* wb = parallel.getNeighborWeights(v);
+                for (int i = 0; i < count; ++i) mismatches += (a[i] != b[i]) + (wa[i] != wb[i]);
+                delete[] a;
+                delete[] b;
+                delete[] wa;
+                delete[] wb;
+            }
+            CHECK(mismatches == 0);
+        }
+    }
+
+    std::remove(path);
+}
+
+// ----------- METIS AND BINARY EDGE LIST TESTS -----------
+
+/**
+ * Test METIS and binary edge-list round trips and error handling.
+ */
+TEST_CASE("METIS and binary edge lists") {
+    const char* path = "exchange_test.bin";
+    Graph g(5);
+    g.addEdge(0, 1, 4);
+    g.addEdge(0, 2, 1);
+    g.addEdge(1, 2, -3);
+    g.addEdge(3, 4, 7);
+    g.addEdge(1, 3, 2);
+
+    auto sameGraph = [](const Graph& a, const Graph& b) {
+        REQUIRE(a.getNumVertices() == b.getNumVertices());
+        CHECK(a.countEdges() == b.countEdges());
+        CHECK(a.direction() == b.direction());
+        int mismatches = 0;
+        for (int u = 0; u < a.getNumVertices(); ++u) {
+            for (int v = 0; v < a.getNumVertices(); ++v) {
+                mismatches += a.getEdgeWeight(u, v) != b.getEdgeWeight(u, v);
+            }
+        }
+        CHECK(mismatches == 0);
+    };
+
+    SUBCASE("METIS round trip") {
+        writeMetis(g, path);
+        Graph loaded = readMetis(path);
+        sameGraph(g, loaded);
+    }
+
+    SUBCASE("METIS reading") {
+        writeFile(path, "% comment\n4 3 011\n5 2 7\n1 1 7 3 2\n2 2 2 4 9\n% late comment\n3 3 9\n");
+        Graph loaded = readMetis(path);
+        CHECK(loaded.countEdges() == 3);
+        CHECK(loaded.getEdgeWeight(0, 1) == 7);
+        CHECK(loaded.getEdgeWeight(2, 1) == 2);
+        CHECK(loaded.getEdgeWeight(2, 3) == 9);
+
+        writeFile(path, "3 1\n2\n1\n\n");
+        CHECK(readMetis(path).getEdgeWeight(1, 0) == 1);
+        writeFile(path, "3 2\n2\n1\n");
+        CHECK_THROWS_AS(readMetis(path), std::runtime_error);
+        writeFile(path, "2 1\n1\n\n");
+        CHECK_THROWS_AS(readMetis(path), std::runtime_error);
+        writeFile(path, "2 1\n3\n1\n");
+        CHECK_THROWS_AS(readMetis(path), std::runtime_error);
+        writeFile(path, "2 1 12\n5 2\n5 1\n");         ///< A format digit of 2.
+        CHECK_THROWS_AS(readMetis(path), std::runtime_error);
+        writeFile(path, "2 1 020\n5 2\n5 1\n");
+        CHECK_THROWS_AS(readMetis(path), std::runtime_error);
+
+        Graph loop(2);
+        loop.addEdge(1, 1, 1);
+        CHECK_THROWS_AS(writeMetis(loop, path), std::invalid_argument);
+        Graph parallel(3);
+        parallel.addEdge(0, 2, 1);
+        parallel.addEdge(2, 0, 4);
+        CHECK_THROWS_AS(writeMetis(parallel, path), std::invalid_argument);
+        Graph directed(2, Direction::DIRECTED);
+        CHECK_THROWS_AS(writeMetis(directed, path), std::invalid_argument);
+    }
+
+    SUBCASE("binary round trip") {
+        g.addEdge(4, 4, 6);
+        writeBinaryEdgeList(g, path);
+        sameGraph(g, readBinaryEdgeList(path));
+        sameGraph(g, readBinaryEdgeList(path, Direction::UNDIRECTED, true, 4));
+
+        writeBinaryEdgeList(g, path, false);
+        Graph pairs = readBinaryEdgeList(path, Direction::UNDIRECTED, false);
+        CHECK(pairs.countEdges() == g.countEdges());
+        CHECK(pairs.getEdgeWeight(1, 2) == 1);
+
+        Graph d(3, Direction::DIRECTED);
+        d.addEdge(2, 0, 5);
+        d.addEdge(0, 2, 8);
+        writeBinaryEdgeList(d, path);
+        sameGraph(d, readBinaryEdgeList(path, Direction::DIRECTED));
+
+        const unsigned char bytes[12] = {1, 0, 0, 0, 2, 1, 0, 0, 0xfe, 0xff, 0xff, 0xff};   ///< (1, 258, -2).
+        writeFile(path, std::string(reinterpret_cast<const char*>(bytes), sizeof(bytes)));
+        Graph little = readBinaryEdgeList(path, Direction::DIRECTED);
+        CHECK(little.getNumVertices() == 259);
+        CHECK(little.getEdgeWeight(1, 258) == -2);
+        writeBinaryEdgeList(little, path);
+        unsigned char written[13] = {0};
+        std::FILE* file = std::fopen(path, "rb");
+        CHECK(std::fread(written, 1, sizeof(written), file) == sizeof(bytes));
+        std::fclose(file);
+        CHECK(std::memcmp(written, bytes, sizeof(bytes)) == 0);   ///< Little-endian on any host.
+    }
+
+    SUBCASE("binary errors") {
+        writeFile(path, std::string(10, '\0'));
+        CHECK_THROWS_AS(readBinaryEdgeList(path), std::runtime_error);
+        int32_t negative[3] = {0, -4, 1};
+        writeFile(path, std::string(reinterpret_cast<char*>(negative), sizeof(negative)));
+        CHECK_THROWS_AS(readBinaryEdgeList(path), std::runtime_error);
+    }
+
+    std::remove(path);
+}
+
+// ----------- DUMP TESTS -----------
+
+/**
+ * Test buffered dumping and print_graph's output.
+ */
+TEST_CASE("Buffered dump") {
+    Graph g(4);
+    g.addEdge(0, 1, 7);
+    g.addEdge(1, 2, -12);
+    g.addEdge(2, 2, 3);
+
+    SUBCASE("print_graph layout") {
+        std::ostringstream captured;
+        std::streambuf* original = std::cout.rdbuf(captured.rdbuf());
+        g.print_graph();
+        DenseGraph(g).print_graph();
+        std::cout.rdbuf(original);
+        std::string expected =
+            "vertex 0: (1, weight 7) \n"
+            "vertex 1: (2, weight -12) (0, weight 7) \n"
+            "vertex 2: (2, weight 3) (2, weight 3) (1, weight -12) \n"
+            "vertex 3: \n";
+        CHECK(captured.str().substr(0, expected.size()) == expected);
+        CHECK(captured.str().find("vertex 2: (1, weight -12) (2, weight 3) \n", expected.size()) != std::string::npos);
+    }
+
+    SUBCASE("formats in a caller buffer") {
+        char memory[256];
+        OutputBuffer out(memory, sizeof(memory));
+        dump(g, out, DumpFormat::EDGE_LIST);
+        CHECK(std::string(out.text(), out.size()) == "0 1 7\n1 2 -12\n2 2 3\n");
+
+        OutputBuffer dot(memory, sizeof(memory));
+        dump(g, dot, DumpFormat::DOT);
+        CHECK(std::string(dot.text(), dot.size()) ==
+              "graph {\n  0 -- 1 [weight=7];\n  1 -- 2 [weight=-12];\n  2 -- 2 [weight=3];\n  3;\n}\n");
+
+        Graph d(2, Direction::DIRECTED);
+        d.addEdge(1, 0, 5);
+        OutputBuffer arcs(memory, sizeof(memory));
+        dump(d, arcs, DumpFormat::DOT);
+        CHECK(std::string(arcs.text(), arcs.size()) == "digraph {\n  0;\n  1 -> 0 [weight=5];\n}\n");
+
+        BasicGraph<uint64_t, Unweighted> u(3);
+        u.addEdge(2, 1);
+        OutputBuffer plain(memory, sizeof(memory));
+        dump(u, plain, DumpFormat::EDGE_LIST);
+        dump(u, plain);
+        CHECK(std::string(plain.text(), plain.size()) ==
+              "1 2\nvertex 0: \nvertex 1: (2, weight 1) \nvertex 2: (1, weight 1) \n");
+
+        BasicGraph<int, double> real(2);
+        real.addEdge(0, 1, 0.25);
+        BasicGraph<int, uint8_t> small(2);
+        small.addEdge(0, 1, 200);
+        OutputBuffer weights(memory, sizeof(memory));
+        dump(real, weights, DumpFormat::EDGE_LIST);
+        dump(small, weights, DumpFormat::EDGE_LIST);
+        CHECK(std::string(weights.text(), weights.size()) == "0 1 0.25\n0 1 200\n");
+
+        OutputBuffer tiny(memory, 8);
+        CHECK_THROWS_AS(dump(g, tiny), std::length_error);
+    }
+
+    SUBCASE("numbers and file descriptors") {
+        const char* path = "dump_test.txt";
+        int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        REQUIRE(fd >= 0);
+        {
+            OutputBuffer out(fd, 16);     ///< Forces many flushes.
+            out.putInt(-9223372036854775807LL - 1);
+            out.put(' ');
+            out.putUnsigned(18446744073709551615ULL);
+            out.put(' ');
+            out.putInt(0);
+            out.put(" a-long-run-that-exceeds-the-buffer ");
+            out.putInt(1234567);
+            out.flush();
+        }
+        ::close(fd);
+        std::FILE* file = std::fopen(path, "rb");
+        char text[128] = {0};
+        size_t length = std::fread(text, 1, sizeof(text) - 1, file);
+        std::fclose(file);
+        CHECK(std::string(text, length) ==
+              "-9223372036854775808 18446744073709551615 0 a-long-run-that-exceeds-the-buffer 1234567");
+        std::remove(path);
+    }
+}
+
+// ----------- STREAMING INGESTION TESTS -----------
+
+/**
+ * Test applying an edge stream while it is still being written.
+ */
+TEST_CASE("Streaming edge ingestion") {
+    SUBCASE("edges apply before the stream ends") {
+        int pipeEnds[2];
+        REQUIRE(::pipe(pipeEnds) == 0);
+        Graph g(10);
+        EdgeIngestor ingestor(g, pipeEnds[0]);
+
+        std::string first = "0 1 5\n1 2\n# comment\n2 3 x\n4 ";
+        REQUIRE(::write(pipeEnds[1], first.data(), first.size()) == static_cast<ssize_t>(first.size()));
+        CHECK(ingestor.applyBatch());
+        CHECK(g.getEdgeWeight(0, 1) == 5);
+        CHECK(g.getEdgeWeight(2, 1) == 1);
+        CHECK_FALSE(ingestor.stats().finished);
+
+        std::string rest = "5 2\n3 99\n7 8 4";      ///< Split line, out-of-range vertex, no final newline.
+        REQUIRE(::write(pipeEnds[1], rest.data(), rest.size()) == static_cast<ssize_t>(rest.size()));
+        ::close(pipeEnds[1]);
+        ingestor.applyAll();
+        ::close(pipeEnds[0]);
+
+        IngestStats stats = ingestor.stats();
+        CHECK(stats.finished);
+        CHECK(stats.edges_applied == 4);
+        CHECK(stats.edges_rejected == 1);
+        CHECK(stats.lines_malformed == 1);
+        CHECK(stats.bytes_read == static_cast<long long>(first.size() + rest.size()));
+        CHECK(g.getEdgeWeight(4, 5) == 2);
+        CHECK(g.getEdgeWeight(8, 7) == 4);
+        CHECK_FALSE(ingestor.applyBatch());
+    }
+
+    SUBCASE("a full queue stalls the reader") {
+        const char* path = "ingest_test.txt";
+        std::string text;
+        for (int i = 0; i < 1000; ++i) text += std::to_string(i % 50) + " " + std::to_string((i * 7) % 50) + "\n";
+        writeFile(path, text);
+
+        Graph g(50);
+        IngestOptions options;
+        options.batch_edges = 8;
+        options.queue_batches = 2;
+        options.read_bytes = 64;
+        EdgeIngestor ingestor(g, path, options);
+        for (int i = 0; i < 200 && ingestor.stats().producer_stalls == 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        IngestStats waiting = ingestor.stats();
+        CHECK(waiting.producer_stalls >= 1);
+        CHECK(waiting.queue_depth == 2);
+        CHECK(waiting.edges_applied == 0);
+
+        CHECK(ingestor.applyAll() == 1000);
+        IngestStats done = ingestor.stats();
+        CHECK(done.max_queue_depth == 2);
+        CHECK(done.edges_parsed == 1000);
+        CHECK(g.countEdges() == 1000);
+        std::remove(path);
+    }
+
+    SUBCASE("over-long lines and stop") {
+        const char* path = "ingest_test.txt";
+        writeFile(path, std::string(100, '1') + "\n1 2\n");
+        Graph g(3);
+        IngestOptions options;
+        options.read_bytes = 16;
+        {
+            EdgeIngestor ingestor(g, path, options);
+            ingestor.applyAll();
+            CHECK(ingestor.stats().lines_malformed == 1);
+            CHECK(g.containsEdge(1, 2));
+        }
+        int pipeEnds[2];
+        REQUIRE(::pipe(pipeEnds) == 0);
+        {
+            EdgeIngestor idle(g, pipeEnds[0]);
+            idle.stop();
+            CHECK_FALSE(idle.applyBatch());
+        }
+        ::close(pipeEnds[0]);
+        ::close(pipeEnds[1]);
+        CHECK_THROWS_AS(EdgeIngestor(g, "no_such_stream.txt"), std::runtime_error);
+        std::remove(path);
+    }
+}
+
+// ----------- BATCH UPDATE TESTS -----------
+
+/**
+ * Test adding and removing edges in batches.
+ */
+TEST_CASE("Batch edge updates") {
+    const int n = 200;
+    const int m = 3000;
+    Graph::Edge* edges = new Graph::Edge[m];
+    for (int i = 0; i < m; ++i) {
+        if (i % 5 == 0) {
+            edges[i] = {0, i % (n - 1) + 1, i};         ///< Vertex 0 becomes indexed, then dense.
+        } else if (i % 5 == 1) {
+            edges[i] = {1, 2 + i % 40, i};             ///< Parallel edges with distinct weights.
+        } else {
+            edges[i] = {(i * 37) % n, (i * 101 + 13) % n, i};
+        }
+    }
+
+    auto sameLists = [&](const Graph& a, const Graph& b) {
+        for (int v = 0; v < n; ++v) {
+            REQUIRE(a.getNeighborCount(v) == b.getNeighborCount(v));
+            CHECK(a.getEncoding(v) == b.getEncoding(v));
+            int* na = a.getNeighbors(v);
+            int* nb = b.getNeighbors(v);
+            int* wa = a.getNeighborWeights(v);
+            int* wb = b.getNeighborWeights(v);
+            int mismatches = 0;
+            for (int i = 0; i < a.getNeighborCount(v); ++i) {
+                mismatches += (na[i] != nb[i]) + (wa[i] != wb[i]);
+            }
+            CHECK(mismatches == 0);
+            delete[] na;
+            delete[] nb;
+            delete[] wa;
+            delete[] wb;
+        }
+    };
+
+    for (Direction direction : {Direction::UNDIRECTED, Direction::DIRECTED}) {
+        Graph batched(n, direction);
+        Graph sequential(n, direction);
+        batched.addEdges(edges, m / 2);
+        batched.addEdges(edges + m / 2, m - m / 2);
+        for (int i = 0; i < m; ++i) sequential.addEdge(edges[i].src, edges[i].dest, edges[i].weight);
+
+        SUBCASE("addEdges matches repeated addEdge") {
+            CHECK(batched.countEdges() == sequential.countEdges());
+            sameLists(batched, sequential);
+        }
+
+        SUBCASE("removeEdges matches repeated removeEdge") {
+            long long expected = 0;
+            for (int i = 0; i < m; i += 3) {
+                if (!sequential.containsEdge(edges[i].src, edges[i].dest)) continue;
+                sequential.removeEdge(edges[i].src, edges[i].dest);
+                expected++;
+            }
+            Graph::Edge* removals = new Graph::Edge[m / 3 + 1];
+            int count = 0;
+            for (int i = 0; i < m; i += 3) removals[count++] = edges[i];
+            CHECK(batched.removeEdges(removals, count) == expected);
+            CHECK(batched.countEdges() == sequential.countEdges());
+            sameLists(batched, sequential);
+            delete[] removals;
+        }
+    }
+
+    SUBCASE("Missing edges and self-loops") {
+        Graph g(5);
+        Graph::Edge added[4] = {{0, 0, 3}, {0, 1, 1}, {0, 1, 2}, {2, 3, 4}};
+        g.addEdges(added, 4);
+        CHECK(g.countEdges() == 4);
+        Graph::Edge removed[5] = {{0, 0, 0}, {1, 0, 0}, {3, 4, 0}, {1, 0, 0}, {1, 0, 0}};
+        CHECK(g.removeEdges(removed, 5) == 3);      ///< The third copy of 0-1 and 3-4 are missing.
+        CHECK(g.countEdges() == 1);
+        CHECK_FALSE(g.containsEdge(0, 0));
+        CHECK(g.getEdgeWeight(3, 2) == 4);
+        CHECK(g.removeEdges(nullptr, 0) == 0);
+    }
+
+    SUBCASE("Invalid vertices throw and change nothing") {
+        Graph g(5);
+        Graph::Edge bad[2] = {{0, 1, 1}, {1, 5, 1}};
+        CHECK_THROWS_AS(g.addEdges(bad, 2), std::out_of_range);
+        CHECK(g.countEdges() == 0);
+        g.addEdge(0, 1, 1);
+        CHECK_THROWS_AS(g.removeEdges(bad, 2), std::out_of_range);
+        CHECK(g.countEdges() == 1);
+    }
+
+    delete[] edges;
+}
+
+// ----------- PCSR TESTS -----------
+
+/**
+ * Check that every row of g holds the same (neighbor, weight) pairs as the
+ * matching row of expected, listed in ascending neighbor order if ascending.
+ */
+template <typename G>
+static void sameSortedRows(const G& g, const Graph& expected, bool ascending = true) {
+    for (int v = 0; v < expected.getNumVertices(); ++v) {
+        REQUIRE(g.getNeighborCount(v) == expected.getNeighborCount(v));
+        int count = expected.getNeighborCount(v);
+        int* gn = g.getNeighbors(v);
+        int* gw = g.getNeighborWeights(v);
+        int* en = expected.getNeighbors(v);
+        int* ew = expected.getNeighborWeights(v);
+        long long* wanted = new long long[count];
+        long long* actual = new long long[count];
+        for (int i = 0; i < count; ++i) {
+            wanted[i] = static_cast<long long>(en[i]) << 32 | static_cast<unsigned>(ew[i]);
+            actual[i] = static_cast<long long>(gn[i]) << 32 | static_cast<unsigned>(gw[i]);
+        }
+        std::sort(wanted, wanted + count);
+        std::sort(actual, actual + count);
+        int unsorted = 0;
+        int mismatches = 0;
+        for (int i = 0; i < count; ++i) {
+            mismatches += wanted[i] != actual[i];
+            if (i > 0) unsorted += gn[i - 1] > gn[i];
+        }
+        CHECK(mismatches == 0);
+        CHECK((!ascending || unsorted == 0));
+        delete[] gn;
+        delete[] gw;
+        delete[] en;
+        delete[] ew;
+        delete[] wanted;
+        delete[] actual;
+    }
+}
+
+/**
+ * Test the packed-memory-array CSR backend against Graph.
+ */
+TEST_CASE("PCSR graph") {
+    const int n = 300;
+    for (Direction direction : {Direction::UNDIRECTED, Direction::DIRECTED}) {
+        PCSRGraph p(n, direction);
+        Graph g(n, direction);
+        int initial = p.slotCount();
+        for (int i = 0; i < 6000; ++i) {
+            int src = i % 4 == 0 ? 7 : (i * 37) % n;       ///< Vertex 7 becomes a hub.
+            int dest = (i * 101 + 13) % n;
+            p.addEdge(src, dest, i % 97);
+            g.addEdge(src, dest, i % 97);
+        }
+
+        SUBCASE("Insertions match Graph") {
+            CHECK(p.countEdges() == g.countEdges());
+            CHECK(p.slotCount() > initial);
+            sameSortedRows(p, g);
+            for (int v = 0; v < n; v += 13) {
+                for (int u = 0; u < n; u += 7) CHECK(p.containsEdge(v, u) == g.containsEdge(v, u));
+            }
+        }
+
+        SUBCASE("Deletions match Graph and shrink the array") {
+            for (int i = 0; i < 6000; i += 2) {
+                int src = i % 4 == 0 ? 7 : (i * 37) % n;
+                int dest = (i * 101 + 13) % n;
+                p.removeEdge(src, dest);
+                g.removeEdge(src, dest);
+            }
+            CHECK(p.countEdges() == g.countEdges());
+            sameSortedRows(p, g);
+            int half = p.slotCount();
+            for (int i = 1; i < 6000; i += 2) {
+                int src = i % 4 == 0 ? 7 : (i * 37) % n;
+                p.removeEdge(src, (i * 101 + 13) % n);
+            }
+            CHECK(p.countEdges() == 0);
+            CHECK(p.slotCount() < half);
+            CHECK(p.slotCount() == initial);
+        }
+    }
+
+    SUBCASE("Copy from Graph and run algorithms") {
+        Graph g(n);
+        for (int i = 0; i < 2000; ++i) g.addEdge((i * 37) % n, (i * 101 + 13) % n, 1 + i % 50);
+        for (int v = 0; v + 1 < n; ++v) g.addEdge(v, v + 1, 60);      ///< Connected.
+        PCSRGraph p(g);
+        CHECK(p.countEdges() == g.countEdges());
+        sameSortedRows(p, g);
+        CHECK(totalWeight(Algorithms::kruskal(p)) == totalWeight(Algorithms::kruskal(g)));
+        CHECK(totalWeight(Algorithms::prim(p)) == totalWeight(Algorithms::kruskal(g)));
+        CHECK(Algorithms::bfs(p, 0).countEdges() == n - 1);
+        CHECK(Algorithms::dijkstra(p, 0).countEdges() == n - 1);
+    }
+
+    SUBCASE("Parallel edges, self-loops and errors") {
+        PCSRGraph p(4);
+        p.addEdge(1, 1, 5);
+        p.addEdge(0, 2, 3);
+        p.addEdge(2, 0, 4);
+        CHECK(p.countEdges() == 3);
+        CHECK(p.getNeighborCount(1) == 2);
+        CHECK(p.getEdgeWeight(0, 2) == 4);         ///< Newest parallel copy.
+        p.removeEdge(0, 2);
+        CHECK(p.getEdgeWeight(2, 0) == 3);
+        p.removeEdge(1, 1);
+        CHECK(p.getNeighborCount(1) == 0);
+        CHECK_THROWS_AS(p.removeEdge(1, 1), std::runtime_error);
+        CHECK(p.getEdgeWeight(0, 4) == -1);
+        CHECK_FALSE(p.containsEdge(-1, 0));
+        CHECK(p.getNeighbors(4) == nullptr);
+    }
+
+    SUBCASE("Parallel self-loops on a single vertex") {
+        PCSRGraph p(1, Direction::DIRECTED);    ///< One sentinel leaves the second leaf empty.
+        const int copies = 40;
+        for (int k = 0; k < copies; ++k) p.addEdge(0, 0, k);
+        CHECK(p.countEdges() == copies);
+        CHECK(p.getEdgeWeight(0, 0) == copies - 1);
+        int* neighbors = p.getNeighbors(0);
+        int* weights = p.getNeighborWeights(0);
+        int wrong = 0;
+        for (int k = 0; k < copies; ++k) wrong += neighbors[k] != 0 || weights[k] != k;
+        CHECK(wrong == 0);                      ///< Copies stay in insertion order.
+        delete[] neighbors;
+        delete[] weights;
+        for (int k = copies - 1; k >= 0; --k) {
+            CHECK(p.getEdgeWeight(0, 0) == k);
+            p.removeEdge(0, 0);
+        }
+        CHECK(p.getNeighborCount(0) == 0);
+    }
+}
+
+// ----------- DELTA GRAPH TESTS -----------
+
+/**
+ * Test the snapshot-plus-log backend against Graph.
+ */
+TEST_CASE("Delta overlay graph") {
+    const int n = 250;
+    Graph seed(n);
+    for (int i = 0; i < 1500; ++i) seed.addEdge((i * 37) % n, (i * 101 + 13) % n, i % 89);
+
+    for (bool background : {false, true}) {
+        DeltaOptions options;
+        options.min_delta = 500;
+        options.background = background;
+        DeltaGraph d(seed, options);
+        Graph g(n);
+        for (int i = 0; i < 1500; ++i) g.addEdge((i * 37) % n, (i * 101 + 13) % n, i % 89);
+        sameSortedRows(d, g);
+
+        int queriesDuringCompaction = 0;
+        for (int i = 0; i < 4000; ++i) {
+            int src = i % 3 == 0 ? 5 : (i * 53) % n;       ///< Vertex 5 gets a long record chain.
+            int dest = (i * 29 + 7) % n;
+            if (i % 4 == 3 && g.containsEdge(src, dest)) {
+                d.removeEdge(src, dest);
+                g.removeEdge(src, dest);
+            } else {
+                d.addEdge(src, dest, (src + dest) % 71);   ///< Parallel copies share a weight.
+                g.addEdge(src, dest, (src + dest) % 71);
+            }
+            if (i % 500 == 0) {
+                queriesDuringCompaction += d.isCompacting();
+                sameSortedRows(d, g);
+            }
+        }
+        CHECK(d.countEdges() == g.countEdges());
+        CHECK(d.deltaSize() < 4000);            ///< Compactions folded most of the log.
+        sameSortedRows(d, g);
+        if (!background) CHECK(queriesDuringCompaction == 0);
+
+        d.compact();
+        CHECK(d.deltaSize() == 0);
+        CHECK_FALSE(d.isCompacting());
+        sameSortedRows(d, g);
+        CHECK(totalWeight(Algorithms::kruskal(d)) == totalWeight(Algorithms::kruskal(g)));
+        CHECK(Algorithms::bfs(d, 0).countEdges() == Algorithms::bfs(g, 0).countEdges());
+    }
+
+    SUBCASE("Tombstones cancel the newest copy") {
+        DeltaOptions options;
+        options.background = false;
+        DeltaGraph d(seed, options);
+        int weight = seed.getEdgeWeight(0, 13);
+        REQUIRE(weight >= 0);
+        d.addEdge(0, 13, 500);
+        d.addEdge(0, 13, 600);
+        CHECK(d.getEdgeWeight(13, 0) == 600);
+        d.removeEdge(0, 13);
+        CHECK(d.getEdgeWeight(0, 13) == 500);
+        d.removeEdge(13, 0);
+        CHECK(d.getEdgeWeight(0, 13) == weight);   ///< Back to the snapshot copy.
+        d.addEdge(3, 3, 9);
+        CHECK(d.containsEdge(3, 3));
+        d.removeEdge(3, 3);
+        CHECK_FALSE(d.containsEdge(3, 3));
+        CHECK_THROWS_AS(d.removeEdge(3, 3), std::runtime_error);
+        CHECK(d.countEdges() == seed.countEdges());
+        d.compact();
+        sameSortedRows(d, seed);
+    }
+
+    SUBCASE("Directed and empty graphs") {
+        DeltaGraph d(4, Direction::DIRECTED);
+        d.addEdge(0, 1, 2);
+        CHECK(d.containsEdge(0, 1));
+        CHECK_FALSE(d.containsEdge(1, 0));
+        CHECK(d.getNeighborCount(1) == 0);
+        d.compact();
+        CHECK(d.getEdgeWeight(0, 1) == 2);
+        CHECK(d.countEdges() == 1);
+        CHECK(d.getNeighbors(4) == nullptr);
+    }
+}
+
+// ----------- CONCURRENT GRAPH TESTS -----------
+
+/**
+ * Test writers and lock-free readers sharing one graph.
+ */
+TEST_CASE("Concurrent graph") {
+    const int n = 400;
+    const int m = 20000;
+    const int writers = 4;
+    auto endpoints = [](int i, int& src, int& dest) {
+        src = i % 5 == 0 ? 3 : (i * 37) % n;            ///< Vertex 3 is a contended hub.
+        dest = (i * 101 + 13) % n;
+    };
+
+    for (Direction direction : {Direction::UNDIRECTED, Direction::DIRECTED}) {
+        ConcurrentGraph c(n, direction, 16);
+        std::atomic<int> running(writers);
+        std::atomic<long long> observed(0);
+
+        std::thread readers[2];
+        for (std::thread& reader : readers) {
+            reader = std::thread([&] {
+                long long seen = 0;
+                while (running.load() > 0) {
+                    for (int v = 0; v < n; v += 7) {
+                        c.forEachNeighbor(v, [&seen](int dest, int) { seen += dest >= 0; });
+                        seen += c.containsEdge(v, 3) + (c.getEdgeWeight(3, v) >= 0);
+                    }
+                }
+                observed += seen;
+            });
+        }
+        std::thread threads[writers];
+        for (int t = 0; t < writers; ++t) {
+            threads[t] = std::thread([&, t] {
+                int src, dest;
+                for (int i = t; i < m; i += writers) {
+                    endpoints(i, src, dest);
+                    c.addEdge(src, dest, (src + dest) % 50);   ///< Parallel copies share a weight.
+                }
+                for (int i = t; i < m; i += 3 * writers) {
+                    endpoints(i, src, dest);
+                    c.removeEdge(src, dest);
+                }
+                running--;
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+        for (std::thread& reader : readers) reader.join();
+        CHECK(observed.load() > 0);
+
+        Graph g(n, direction);
+        int src, dest;
+        for (int i = 0; i < m; ++i) {
+            endpoints(i, src, dest);
+            g.addEdge(src, dest, (src + dest) % 50);
+        }
+        for (int i = 0; i < m; ++i) {
+            if (i % (3 * writers) >= writers) continue;     ///< What writer i % writers removed.
+            endpoints(i, src, dest);
+            g.removeEdge(src, dest);
+        }
+        CHECK(c.countEdges() == g.countEdges());
+        for (int v = 0; v < n; ++v) {
+            int degree = 0;
+            c.forEachNeighbor(v, [&degree](int, int) { degree++; });
+            CHECK(degree == c.getNeighborCount(v));
+        }
+        c.reclaim();
+        CHECK(c.pendingReclaim() == 0);
+        sameSortedRows(c, g, false);
+    }
+
+    SUBCASE("Lock-free inserts race on one head") {
+        const int producers = 8;
+        const int each = 5000;
+        ConcurrentGraph c(producers + 1, Direction::DIRECTED, 4);
+        std::atomic<int> done(0);
+        std::thread threads[producers];
+        for (int t = 0; t < producers; ++t) {
+            threads[t] = std::thread([&, t] {
+                for (int i = 0; i < each; ++i) c.addEdge(0, t + 1, t);
+                done++;
+            });
+        }
+        std::thread remover([&] {
+            int removed = 0;
+            while (removed < each) {   ///< Unlinks race with the pushes onto vertex 0.
+                if (c.getEdgeWeight(0, 1) != -1) {
+                    c.removeEdge(0, 1);
+                    removed++;
+                    if (removed % 64 == 0) c.reclaim();
+                }
+            }
+        });
+        for (std::thread& thread : threads) thread.join();
+        remover.join();
+        c.reclaim();
+        CHECK(done.load() == producers);
+        CHECK(c.pendingReclaim() == 0);
+        CHECK(c.getNeighborCount(0) == (producers - 1) * each);
+        CHECK(c.countEdges() == (producers - 1) * each);
+        ConcurrentGraph::ReadView view(c);
+        for (int t = 0; t < producers; ++t) {
+            int copies = 0;
+            view.forEachNeighbor(0, [&copies, t](int dest, int weight) { copies += dest == t + 1 && weight == t; });
+            CHECK(copies == (t == 0 ? 0 : each));
+        }
+    }
+
+    SUBCASE("Several graphs in one thread") {
+        ConcurrentGraph* graphs[6];
+        for (ConcurrentGraph*& g : graphs) g = new ConcurrentGraph(4);
+        for (int round = 0; round < 300; ++round) {
+            for (ConcurrentGraph* g : graphs) g->addEdge(round % 4, (round + 1) % 4, round);
+            if (round % 3 == 2) {
+                for (ConcurrentGraph* g : graphs) g->removeEdge(round % 4, (round + 1) % 4);
+                delete graphs[round % 6];
+                graphs[round % 6] = new ConcurrentGraph(4);
+            }
+        }
+        for (ConcurrentGraph* g : graphs) {
+            g->reclaim();
+            CHECK(g->pendingReclaim() == 0);
+            delete g;
+        }
+    }
+
+    SUBCASE("Read views stay consistent while writers run") {
+        const int size = 200;
+        ConcurrentGraph c(size, Direction::UNDIRECTED, 16, 4);
+        for (int v = 0; v + 1 < size; ++v) c.addEdge(v, v + 1, 5);   ///< Never removed.
+        std::atomic<int> running(2);
+        std::atomic<int> failures(0);
+        std::atomic<int> views(0);
+
+        std::thread churn[2];
+        for (int t = 0; t < 2; ++t) {
+            churn[t] = std::thread([&, t] {
+                for (int i = 0; i < 20000; ++i) {
+                    int src = (i * 13 + t) % size;
+                    int dest = (i * 29 + 7) % size;
+                    c.addEdge(src, dest, 1 + i % 9);
+                    if (i % 2 == 1) c.removeEdge(src, dest);
+                }
+                running--;
+            });
+        }
+        std::thread readers[3];
+        for (std::thread& reader : readers) {
+            reader = std::thread([&] {
+                while (running.load() > 0) {
+                    ConcurrentGraph::ReadView view(c);
+                    int edges = view.countEdges();
+                    Graph tree = Algorithms::bfs(view, 0);
+                    Graph paths = Algorithms::dijkstra(view, size - 1);
+                    if (tree.countEdges() != size - 1 || paths.countEdges() != size - 1) failures++;
+                    if (view.countEdges() != edges) failures++;   ///< Repeatable reads.
+                    views++;
+                }
+            });
+        }
+        for (std::thread& thread : churn) thread.join();
+        for (std::thread& reader : readers) reader.join();
+        CHECK(failures.load() == 0);
+        CHECK(views.load() > 0);
+        CHECK(c.countEdges() == size - 1 + 20000);
+        c.reclaim();
+        CHECK(c.pendingReclaim() == 0);
+    }
+
+    SUBCASE("Views keep the order of updates from different threads") {
+        const int steps = 2000;
+        ConcurrentGraph c(steps + 2, Direction::DIRECTED, 4, 2);
+        c.addEdge(0, 1);
+        std::atomic<int> turn(0);
+        std::atomic<int> empty(0);
+        std::thread writers[2];     ///< One adds the next edge, then the other removes the old one.
+        for (int t = 0; t < 2; ++t) {
+            writers[t] = std::thread([&, t] {
+                for (int i = 0; i < steps; ++i) {
+                    while (turn.load() != 2 * i + t) std::this_thread::yield();
+                    if (t == 0) {
+                        c.addEdge(0, i + 2);
+                    } else {
+                        c.removeEdge(0, i + 1);
+                    }
+                    turn++;
+                }
+            });
+        }
+        std::thread reader([&] {
+            while (turn.load() < 2 * steps) {
+                ConcurrentGraph::ReadView view(c);
+                if (view.getNeighborCount(0) == 0) empty++;   ///< A removal seen without the add before it.
+            }
+        });
+        for (std::thread& writer : writers) writer.join();
+        reader.join();
+        CHECK(empty.load() == 0);
+        CHECK(c.getNeighborCount(0) == 1);
+    }
+
+    SUBCASE("Removed edges outlive the views that see them") {
+        ConcurrentGraph c(8, Direction::UNDIRECTED, 4, 2);
+        for (int v = 0; v < 7; ++v) c.addEdge(v, v + 1, v);
+        {
+            ConcurrentGraph::ReadView view(c);
+            for (int v = 0; v < 7; ++v) c.removeEdge(v, v + 1);
+            c.addEdge(0, 7, 9);
+            c.reclaim();
+            CHECK(c.pendingReclaim() == 14);
+            CHECK(view.countEdges() == 7);
+            CHECK(view.getEdgeWeight(3, 4) == 3);
+            CHECK_FALSE(view.containsEdge(0, 7));
+            CHECK(c.countEdges() == 1);
+            CHECK_FALSE(c.containsEdge(3, 4));
+
+            ConcurrentGraph::ReadView later(c);
+            CHECK(later.countEdges() == 1);
+        }
+        c.reclaim();
+        CHECK(c.pendingReclaim() == 0);
+        CHECK(c.getNeighborCount(0) == 1);
+    }
+
+    SUBCASE("Parallel copies pushed in opposite orders") {
+        const int adders = 4;
+        const int each = 1000;
+        ConcurrentGraph c(3, Direction::UNDIRECTED, 4);
+        std::atomic<int> running(adders);
+        std::thread threads[adders];
+        for (int t = 0; t < adders; ++t) {
+            threads[t] = std::thread([&, t] {   ///< Copies of 0-1 interleave differently in rows 0 and 1.
+                for (int i = 0; i < each; ++i) c.addEdge(t % 2 == 0 ? 0 : 1, t % 2 == 0 ? 1 : 0, t * each + i);
+                running--;
+            });
+        }
+        std::thread remover([&] {
+            int removed = 0;
+            while (removed < adders * each / 2) {
+                if (!c.containsEdge(0, 1)) {
+                    if (running.load() == 0) break;
+                    continue;
+                }
+                c.removeEdge(removed % 2 == 0 ? 0 : 1, removed % 2 == 0 ? 1 : 0);
+                removed++;
+            }
+        });
+        for (std::thread& thread : threads) thread.join();
+        remover.join();
+
+        ConcurrentGraph::ReadView view(c);
+        CHECK(view.getEdgeWeight(0, 1) == view.getEdgeWeight(1, 0));
+        CHECK(view.getNeighborCount(0) == view.getNeighborCount(1));
+        int count = view.getNeighborCount(0);
+        int* forward = view.getNeighborWeights(0);
+        int* backward = view.getNeighborWeights(1);
+        std::sort(forward, forward + count);
+        std::sort(backward, backward + count);
+        bool same = true;
+        for (int i = 0; i < count; ++i) same = same && forward[i] == backward[i];
+        CHECK(same);   ///< Both halves of every removed copy went together.
+        delete[] forward;
+        delete[] backward;
+
+        int mismatches = 0;
+        for (int i = 0; c.containsEdge(0, 1); ++i) {   ///< Drain the copies, checking both rows agree each step.
+            mismatches += c.getEdgeWeight(0, 1) != c.getEdgeWeight(1, 0);
+            c.removeEdge(i % 2 == 0 ? 1 : 0, i % 2 == 0 ? 0 : 1);
+        }
+        CHECK(mismatches == 0);
+        CHECK(c.getNeighborCount(1) == 0);
+    }
+
+    SUBCASE("Nodes freed by another thread are reused") {
+        const int phases = 100;
+        const int each = 1000;   ///< Few enough removals that writers never reclaim themselves.
+        ConcurrentGraph c(2, Direction::UNDIRECTED, 4);
+        for (int phase = 0; phase < phases; ++phase) {
+            std::thread writer([&c, phase] {
+                for (int i = 0; i < each; ++i) {
+                    c.addEdge(0, 1, phase);
+                    c.removeEdge(0, 1);
+                }
+            });
+            writer.join();
+            c.reclaim();
+        }
+        CHECK(c.pendingReclaim() == 0);
+        CHECK(c.allocatedNodes() < 4 * each);   ///< Without reuse every phase takes 2 * each nodes.
+        CHECK(c.countEdges() == 0);
+    }
+
+    SUBCASE("Opposite endpoint orders do not deadlock") {
+        ConcurrentGraph c(64, Direction::UNDIRECTED, 4);
+        std::thread forward([&c] {
+            for (int i = 0; i < 20000; ++i) c.addEdge(i % 64, (i * 7 + 1) % 64, 1);
+        });
+        std::thread backward([&c] {
+            for (int i = 0; i < 20000; ++i) c.addEdge((i * 7 + 1) % 64, i % 64, 1);
+        });
+        forward.join();
+        backward.join();
+        CHECK(c.countEdges() == 40000);
+    }
+
+    SUBCASE("Errors and self-loops") {
+        ConcurrentGraph c(3);
+        c.addEdge(1, 1, 4);
+        CHECK(c.getNeighborCount(1) == 2);
+        CHECK(c.countEdges() == 1);
+        c.removeEdge(1, 1);
+        CHECK(c.getNeighborCount(1) == 0);
+        CHECK_THROWS_AS(c.removeEdge(0, 2), std::runtime_error);
+        CHECK(c.getEdgeWeight(0, 3) == -1);
+        CHECK(c.getNeighbors(3) == nullptr);
+    }
+}
+
+// ----------- WORK POOL TESTS -----------
+
+/// Hop distance from start to every vertex along out-edges, -1 if unreachable.
+template <typename G>
+static int* hopLevels(const G& g, int start) {
+    int n = g.getNumVertices();
+    int* level = new int[n];
+    int* queue = new int[n];
+    for (int v = 0; v < n; ++v) level[v] = -1;
+    int head = 0, tail = 0;
+    level[start] = 0;
+    queue[tail++] = start;
+    while (head < tail) {
+        int u = queue[head++];
+        int count = g.getNeighborCount(u);
+        int* neighbors = g.getNeighbors(u);
+        for (int i = 0; i < count; ++i) {
+            if (level[neighbors[i]] == -1) {
+                level[neighbors[i]] = level[u] + 1;
+                queue[tail++] = neighbors[i];
+            }
+        }
+        delete[] neighbors;
+    }
+    delete[] queue;
+    return level;
+}
+
+TEST_CASE("Work-stealing pool and parallel algorithms") {
+    const int n = 3000;
+    const int m = 30000;
+    auto endpoints = [](int i, int& src, int& dest) {
+        src = i % 4 == 0 ? i % 5 : (i * 7919) % n;     ///< Vertices 0-4 own a quarter of the edges.
+        dest = (i * 7907 + 17) % n;
+    };
+
+    SUBCASE("Chunks cover every item once and split by cost") {
+        const long long count = 100000;
+        const long long grain = 5000;
+        long long* costs = new long long[count + 1];
+        costs[0] = 0;
+        for (long long i = 0; i < count; ++i) costs[i + 1] = costs[i] + (i == 0 || i == 777 ? 1000000 : 0);
+        std::atomic<int>* hits = new std::atomic<int>[count];
+        for (unsigned threads : {1u, 2u, 4u, 8u}) {
+            WorkPool pool(threads);
+            CHECK(pool.size() == threads);
+            for (int round = 0; round < 3; ++round) {
+                for (long long i = 0; i < count; ++i) hits[i].store(0);
+                std::atomic<int> oversized(0);
+                std::atomic<int> chunks(0);
+                pool.forEachChunk(count, costs, grain, [&](long long begin, long long end) {
+                    for (long long i = begin; i < end; ++i) hits[i]++;
+                    long long cost = end - begin + costs[end] - costs[begin];
+                    if (end - begin > 1 && cost > grain) oversized++;
+                    chunks++;
+                });
+                int wrong = 0;
+                for (long long i = 0; i < count; ++i) wrong += hits[i].load() != 1;
+                CHECK(wrong == 0);
+                CHECK(chunks.load() >= count / grain);
+                if (threads == 1) CHECK(oversized.load() == 0);   ///< One worker never fills its deque.
+            }
+            int calls = 0;
+            pool.forEachChunk(0, 1, [&calls](long long, long long) { calls++; });
+            CHECK(calls == 0);
+        }
+        delete[] hits;
+        delete[] costs;
+    }
+
+    WorkPool pool(4);
+
+    SUBCASE("Parallel BFS reaches every vertex at its BFS depth") {
+        for (Direction direction : {Direction::UNDIRECTED, Direction::DIRECTED}) {
+            Graph g(n, direction);
+            int src, dest;
+            for (int i = 0; i < m; ++i) {
+                endpoints(i, src, dest);
+                g.addEdge(src, dest, i % 97 + 1);
+            }
+            for (int start : {0, 1234}) {
+                Graph tree = Algorithms::parallelBfs(g, start, pool);
+                int* expected = hopLevels(g, start);
+                int* actual = hopLevels(tree, start);
+                int reached = 0, mismatched = 0;
+                for (int v = 0; v < n; ++v) {
+                    reached += expected[v] != -1;
+                    mismatched += expected[v] != actual[v];
+                }
+                CHECK(mismatched == 0);
+                CHECK(tree.countEdges() == reached - 1);
+                delete[] expected;
+                delete[] actual;
+            }
+            PCSRGraph p(g);
+            Graph fromCopy = Algorithms::parallelBfs(p, 0, pool);
+            CHECK(fromCopy.countEdges() == Algorithms::bfs(g, 0).countEdges());
+        }
+        Graph empty = Algorithms::parallelBfs(Graph(3), 5, pool);
+        CHECK(empty.countEdges() == 0);
+    }
+
+    SUBCASE("Connected components match a sequential union-find") {
+        Graph g(n, Direction::DIRECTED);
+        unionFind<int> uf(n);
+        for (int i = 0; i < m / 4; ++i) {
+            int src = (i * 7919) % n;
+            int dest = (src / 100) * 100 + (i * 31) % 60;   ///< Stays within a block of 100.
+            g.addEdge(src, dest);
+            uf.unite(src, dest);
+        }
+        int* labels = Algorithms::connectedComponents(g, pool);
+        int* smallest = new int[n];
+        for (int v = 0; v < n; ++v) smallest[v] = n;
+        for (int v = 0; v < n; ++v) smallest[uf.find(v)] = std::min(smallest[uf.find(v)], v);
+        int wrong = 0;
+        for (int v = 0; v < n; ++v) wrong += labels[v] != smallest[uf.find(v)];
+        CHECK(wrong == 0);
+        CHECK(labels[n - 1] != labels[0]);
+        delete[] labels;
+        delete[] smallest;
+    }
+
+    SUBCASE("Boruvka builds a minimum spanning forest") {
+        Graph g(n);
+        int src, dest;
+        for (int i = 0; i < m; ++i) {
+            endpoints(i, src, dest);
+            g.addEdge(src, dest, (i * 31) % 97 + 1);
+        }
+        for (int v = 0; v + 1 < n; ++v) g.addEdge(v, v + 1, 500 + v % 3);   ///< Connected, with weight ties.
+        Graph mst = Algorithms::boruvka(g, pool);
+        CHECK(mst.countEdges() == n - 1);
+
+        Graph::Edge* sorted = new Graph::Edge[g.countEdges()];   ///< Reference Kruskal with a real sort.
+        long long count = 0;
+        for (int u = 0; u < n; ++u) {
+            int degree = g.getNeighborCount(u);
+            int* neighbors = g.getNeighbors(u);
+            int* weights = g.getNeighborWeights(u);
+            for (int i = 0; i < degree; ++i) {
+                if (u < neighbors[i]) sorted[count++] = {u, neighbors[i], weights[i]};
+            }
+            delete[] neighbors;
+            delete[] weights;
+        }
+        std::sort(sorted, sorted + count, [](const Graph::Edge& a, const Graph::Edge& b) { return a.weight < b.weight; });
+        unionFind<int> uf(n);
+        long long minimum = 0;
+        for (long long i = 0; i < count; ++i) {
+            if (uf.find(sorted[i].src) == uf.find(sorted[i].dest)) continue;
+            uf.unite(sorted[i].src, sorted[i].dest);
+            minimum += sorted[i].weight;
+        }
+        delete[] sorted;
+        CHECK(totalWeight(mst) == minimum);
+        int* levels = hopLevels(mst, 0);
+        int unreached = 0;
+        for (int v = 0; v < n; ++v) unreached += levels[v] == -1;
+        CHECK(unreached == 0);
+        delete[] levels;
+
+        Graph forest(6);
+        forest.addEdge(0, 1, 3);
+        forest.addEdge(1, 2, 1);
+        forest.addEdge(0, 2, 2);
+        forest.addEdge(3, 4, 7);
+        forest.addEdge(3, 4, 5);
+        Graph f = Algorithms::boruvka(forest, pool);
+        CHECK(f.countEdges() == 3);
+        CHECK(totalWeight(f) == 8);
+        CHECK(f.getEdgeWeight(3, 4) == 5);
+
+        BasicGraph<int, Unweighted> unweighted(4);
+        unweighted.addEdge(0, 1);
+        unweighted.addEdge(1, 2);
+        unweighted.addEdge(2, 0);
+        CHECK(Algorithms::boruvka(unweighted, pool).countEdges() == 2);
+        CHECK_THROWS_AS(Algorithms::boruvka(Graph(3, Direction::DIRECTED), pool), std::invalid_argument);
+    }
+}
@@ -0,0 +1,88 @@
+// ronavraham99@gmail.com
+
+#ifndef TEXT_SCANNER_HPP
+#define TEXT_SCANNER_HPP
+
+#include <cstring>
+
+namespace graph {
+
+/**
+ * @brief Cursor over a range of text, one line at a time.
+ *
+ * Blanks are spaces, tabs and carriage returns, so CRLF files parse too.
+ */
+struct Scanner {
+    const char* at;     ///< Next unread character.
+    const char* end;    ///< End of the range.
+
+    void skipBlanks() {
+        while (at < end && (*at == ' ' || *at == '\t' || *at == '\r')) ++at;
+    }
+
+    /// @return True once the rest of the line is blank.
+    bool atLineEnd() {
+        skipBlanks();
+        return at == end || *at == '\n';
+    }
+
+    /// Move to the first character of the next line.
+    void nextLine() {
+        const char* newline = static_cast<const char*>(std::memchr(at, '\n', end - at));
+        at = newline == nullptr ? end : newline + 1;
+    }
+
+    /**
+     * @brief Read a decimal integer followed by a blank or the end of the line.
+     * @return False if there is no integer, it has more than 18 digits, or it
+     *         runs into another character.
+     */
+    bool readInt(long long& value) {
+        skipBlanks();
+        bool negative = at < end && *at == '-';
+        if (negative) ++at;
+        const char* digits = at;
+        long long result = 0;
+        while (at < end && static_cast<unsigned>(*at - '0') < 10) {
+            result = result * 10 + (*at - '0');
+            ++at;
+        }
+        if (at == digits || at - digits > 18) return false;
+        if (at < end && *at != ' ' && *at != '\t' && *at != '\r' && *at != '\n') return false;
+        value = negative ? -result : result;
+        return true;
+    }
+
+    /**
+     * @brief Read a word and compare it, case-insensitively, with an expected one.
+     * @param expected Lower-case word.
+     */
+    bool readWord(const char* expected) {
+        skipBlanks();
+        for (; *expected != '\0'; ++expected, ++at) {
+            if (at == end || (*at | 0x20) != *expected) return false;
+        }
+        return at == end || *at == ' ' || *at == '\t' || *at == '\r' || *at == '\n';
+    }
+
+    /**
+     * @brief Read a SNAP-style edge line, "src dest" or "src dest weight".
+     *
+     * Blank lines and lines starting with '#' or '%' hold no edge. A
+     * missing weight is 1.
+     * @return EDGE if an edge was read, NONE for a blank or comment line,
+     *         MALFORMED otherwise.
+     */
+    enum LineKind {NONE, EDGE, MALFORMED};
+    LineKind readEdgeLine(long long& src, long long& dest, long long& weight) {
+        if (atLineEnd() || *at == '#' || *at == '%') return NONE;
+        weight = 1;
+        if (!readInt(src) || !readInt(dest)) return MALFORMED;
+        if (!atLineEnd() && (!readInt(weight) || !atLineEnd())) return MALFORMED;
+        return EDGE;
+    }
+};
+
+} // namespace graph
+
+#endif // TEXT_SCANNER_HPP
@@ -0,0 +1,168 @@
+// ronavraham99@gmail.com
+
+#include "WorkPool.hpp"
+#include "Parallel.hpp"
+#include <limits>
+
+namespace graph {
+
+/**
+ * @brief Start the worker threads.
+ * @param threads Workers including the calling thread, 0 for one per
+ *        hardware thread. A pool of one spawns nothing.
+ */
+WorkPool::WorkPool(unsigned threads)
+    : worker_count(workerCount(threads, std::numeric_limits<long long>::max())),
+      generation(0), stopping(false), active(0), job{nullptr, nullptr, nullptr, 1}, remaining(0) {
+    workers = new Worker[worker_count];
+    for (unsigned t = 0; t < worker_count; ++t) {
+        workers[t].top = 0;
+        workers[t].bottom = 0;
+        workers[t].seed = 0x9E3779B97F4A7C15ULL * (t + 1);
+    }
+    this->threads = new std::thread[worker_count - 1];
+    for (unsigned t = 1; t < worker_count; ++t) {
+        this->threads[t - 1] = std::thread(&WorkPool::loop, this, t);
+    }
+}
+
+/// Stop and join the worker threads.
+WorkPool::~WorkPool() {
+    {
+        std::lock_guard<std::mutex> guard(job_lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (unsigned t = 1; t < worker_count; ++t) threads[t - 1].join();
+    delete[] threads;
+    delete[] workers;
+}
+
+/**
+ * @brief Post a job, work on it from the calling thread, and wait until
+ *        every worker has left it.
+ *
+ * Taking job_lock around posting and leaving orders everything written
+ * before the call before the chunks, and everything the chunks wrote
+ * before the return.
+ */
+void WorkPool::run(long long count, const long long* costs, long long grain, Call call, void* context) {
+    if (count <= 0) return;
+    {
+        std::lock_guard<std::mutex> guard(job_lock);
+        job = Job{call, context, costs, grain < 1 ? 1 : grain};
+        remaining.store(count);
+        push(0, Range{0, count});
+        active = worker_count - 1;
+        generation++;
+    }
+    wake.notify_all();
+    work(0);
+    std::unique_lock<std::mutex> lock(job_lock);
+    idle.wait(lock, [this] { return active == 0; });
+}
+
+/// Body of worker thread self: sleep until a job is posted, then work on it.
+void WorkPool::loop(unsigned self) {
+    unsigned long long seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(job_lock);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        work(self);
+        std::lock_guard<std::mutex> guard(job_lock);
+        if (--active == 0) idle.notify_one();
+    }
+}
+
+/**
+ * @brief Take and run chunks until every item of the job is done.
+ *
+ * The upper half of a range goes back on the deque, where a thief finds
+ * it, and the worker carries on with the lower half.
+ */
+void WorkPool::work(unsigned self) {
+    Range range;
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (!pop(self, range) && !steal(self, range)) {
+            std::this_thread::yield();
+            continue;
+        }
+        while (range.end - range.begin > 1 && cost(range) > job.grain) {
+            long long middle = split(range);
+            if (!push(self, Range{middle, range.end})) break;
+            range.end = middle;
+        }
+        job.call(job.context, range.begin, range.end);
+        remaining.fetch_sub(range.end - range.begin, std::memory_order_acq_rel);
+    }
+}
+
+/// Push a range on the bottom of a worker's deque. @return False if the deque is full.
+bool WorkPool::push(unsigned self, const Range& range) {
+    Worker& worker = workers[self];
+    std::lock_guard<std::mutex> guard(worker.lock);
+    if (worker.bottom - worker.top == DEQUE_CAPACITY) return false;
+    worker.ranges[worker.bottom++ % DEQUE_CAPACITY] = range;
+    return true;
+}
+
+/// Pop the newest range of a worker's own deque. @return False if it is empty.
+bool WorkPool::pop(unsigned self, Range& range) {
+    Worker& worker = workers[self];
+    std::lock_guard<std::mutex> guard(worker.lock);
+    if (worker.bottom == worker.top) return false;
+    range = worker.ranges[--worker.bottom % DEQUE_CAPACITY];
+    return true;
+}
+
+/**
+ * @brief Take the oldest range of another worker, trying every worker once
+ *        from a random one.
+ * @return False if no other worker had work.
+ */
+bool WorkPool::steal(unsigned self, Range& range) {
+    Worker& thief = workers[self];
+    thief.seed ^= thief.seed << 13;   ///< xorshift64; seed is only touched by its own worker.
+    thief.seed ^= thief.seed >> 7;
+    thief.seed ^= thief.seed << 17;
+    unsigned first = static_cast<unsigned>(thief.seed % worker_count);
+    for (unsigned i = 0; i < worker_count; ++i) {
+        unsigned victim = (first + i) % worker_count;
+        if (victim == self) continue;
+        Worker& worker = workers[victim];
+        std::lock_guard<std::mutex> guard(worker.lock);
+        if (worker.bottom == worker.top) continue;
+        range = worker.ranges[worker.top++ % DEQUE_CAPACITY];
+        return true;
+    }
+    return false;
+}
+
+/// @return Cost of a range: one per item plus its share of the job's costs.
+long long WorkPool::cost(const Range& range) const {
+    long long items = range.end - range.begin;
+    if (job.costs == nullptr) return items;
+    return items + job.costs[range.end] - job.costs[range.begin];
+}
+
+/// @return Split point in (begin, end): the first item at which the lower part reaches half the cost.
+long long WorkPool::split(const Range& range) const {
+    long long half = cost(range) / 2;
+    long long low = range.begin + 1;
+    long long high = range.end - 1;
+    while (low < high) {
+        long long middle = low + (high - low) / 2;
+        if (cost(Range{range.begin, middle}) < half) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+} // namespace graph
@@ -0,0 +1,119 @@
+// ronavraham99@gmail.com
+
+#ifndef WORK_POOL_HPP
+#define WORK_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace graph {
+
+/**
+ * @class WorkPool
+ * @brief Fixed set of worker threads that share ranges of work by stealing.
+ *
+ * forEachChunk(count, costs, grain, body) covers [0, count) with calls
+ * body(begin, end). The whole range starts on the deque of the calling
+ * thread, which works as worker 0. A worker takes the newest range of its
+ * own deque and halves it, pushing the upper half back, until what it
+ * holds costs at most grain; an idle worker steals the oldest (largest)
+ * range of a randomly chosen victim.
+ *
+ * A range is halved at the midpoint of its cost rather than its length.
+ * With costs the prefix sum of per-item edge counts, a few hub vertices
+ * that own most of the edges end up in chunks of their own instead of
+ * stalling one static slice.
+ *
+ * body must not throw and must not call back into the same pool; a pool
+ * runs one forEachChunk at a time.
+ */
+class WorkPool {
+public:
+    explicit WorkPool(unsigned threads = 0);
+    ~WorkPool();
+    WorkPool(const WorkPool&) = delete;
+    WorkPool& operator=(const WorkPool&) = delete;
+
+    /// @return Number of workers, the calling thread included.
+    unsigned size() const {return worker_count;}
+
+    /**
+     * @brief Run body(begin, end) over chunks covering [0, count).
+     * @param count Number of items.
+     * @param costs Prefix sum of item costs (count + 1 entries, costs[i] is the
+     *        cost of the items before i), or nullptr. Every item costs one more.
+     * @param grain Cost at which a chunk is no longer split.
+     * @param body Called as body(begin, end), possibly from several threads at once.
+     */
+    template <typename Body>
+    void forEachChunk(long long count, const long long* costs, long long grain, Body body) {
+        run(count, costs, grain, &invoke<Body>, &body);
+    }
+
+    /// forEachChunk over items of equal cost.
+    template <typename Body>
+    void forEachChunk(long long count, long long grain, Body body) {
+        forEachChunk(count, nullptr, grain, body);
+    }
+
+private:
+    typedef void (*Call)(void* context, long long begin, long long end);
+
+    template <typename Body>
+    static void invoke(void* context, long long begin, long long end) {
+        (*static_cast<Body*>(context))(begin, end);
+    }
+
+    /// Half-open range of items.
+    struct Range {
+        long long begin;
+        long long end;
+    };
+
+    /// Ranges one worker holds; a worker with a full deque stops splitting.
+    static constexpr int DEQUE_CAPACITY = 64;
+
+    struct alignas(64) Worker {
+        std::mutex lock;
+        Range ranges[DEQUE_CAPACITY];   ///< Circular, oldest at top.
+        long long top;
+        long long bottom;
+        unsigned long long seed;        ///< State of the victim choice.
+    };
+
+    /// The forEachChunk call being run.
+    struct Job {
+        Call call;
+        void* context;
+        const long long* costs;
+        long long grain;
+    };
+
+    unsigned worker_count;
+    Worker* workers;
+    std::thread* threads;       ///< Workers 1 .. worker_count - 1.
+
+    std::mutex job_lock;
+    std::condition_variable wake;     ///< A job was posted or the pool is stopping.
+    std::condition_variable idle;     ///< The last worker left the job.
+    unsigned long long generation;    ///< Jobs posted, guarded by job_lock.
+    bool stopping;                    ///< Guarded by job_lock.
+    unsigned active;                  ///< Threads still in the job, guarded by job_lock.
+    Job job;
+    std::atomic<long long> remaining; ///< Items of the job not yet done.
+
+    void run(long long count, const long long* costs, long long grain, Call call, void* context);
+    void loop(unsigned self);
+    void work(unsigned self);
+    bool push(unsigned self, const Range& range);
+    bool pop(unsigned self, Range& range);
+    bool steal(unsigned self, Range& range);
+    long long cost(const Range& range) const;
+    long long split(const Range& range) const;
+};
+
+} // namespace graph
+
+#endif // WORK_POOL_HPP